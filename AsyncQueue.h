@@ -0,0 +1,237 @@
+#pragma once
+
+#include "Volk/volk.h"
+#include "DeletionQueue.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <vector>
+
+// L[ւ̓̊\. ^CCZ}tH̒lɒB犮.
+struct QueueSyncPoint
+{
+	VkSemaphore semaphore = VK_NULL_HANDLE;
+	uint64_t value = 0;
+
+	bool IsValid() const { return semaphore != VK_NULL_HANDLE; }
+};
+
+// ɑ҂킹鑊ƁA҂pCvCXe[W.
+struct QueueWait
+{
+	QueueSyncPoint point;
+	VkPipelineStageFlags stage;
+};
+
+// OtBbNXȊÕL[ (񓯊Rs[gA]) ւ̓󂯎.
+// ƂɃL[p̃^CCZ}tHVOiÃL[͂̒l҂Čʂg.
+// ̓_[Xbĥݍs.
+class AsyncQueue
+{
+public:
+	void Initialize(VkDevice device, DeletionQueue& deletionQueue, uint32_t familyIndex, uint32_t queueIndex,
+		PFN_vkGetSemaphoreCounterValue getSemaphoreCounterValue)
+	{
+		m_device = device;
+		m_deletionQueue = &deletionQueue;
+		m_familyIndex = familyIndex;
+		m_getSemaphoreCounterValue = getSemaphoreCounterValue;
+		vkGetDeviceQueue(m_device, familyIndex, queueIndex, &m_queue);
+
+		VkSemaphoreTypeCreateInfo semaphoreTypeInfo{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+			.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+			.initialValue = 0,
+		};
+		VkSemaphoreCreateInfo semaphoreCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+			.pNext = &semaphoreTypeInfo,
+		};
+		vkCreateSemaphore(m_device, &semaphoreCreateInfo, nullptr, &m_semaphore);
+		m_deletionQueue->Track(m_semaphore);
+	}
+
+	// serial ͔j\񂷂t[̒ʂԍ. ĂяoŃL[̊ۏ؂邱.
+	void Shutdown(uint64_t serial)
+	{
+		for (auto& batch : m_inFlight)
+		{
+			m_freeBatches.push_back(batch);
+		}
+		m_inFlight.clear();
+		for (auto& batch : m_freeBatches)
+		{
+			m_deletionQueue->Destroy(batch.commandPool, serial);
+		}
+		m_freeBatches.clear();
+		m_deletionQueue->Destroy(m_semaphore, serial);
+	}
+
+	// L^JnR}hobt@Ԃ. Submit() ܂łɑ Begin() Ă΂Ȃ.
+	VkCommandBuffer Begin()
+	{
+		Recycle();
+		if (m_freeBatches.empty())
+		{
+			m_freeBatches.push_back(CreateBatch());
+		}
+		m_recording = m_freeBatches.back();
+		m_freeBatches.pop_back();
+
+		vkResetCommandPool(m_device, m_recording.commandPool, 0);
+		VkCommandBufferBeginInfo beginInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+			.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+		};
+		vkBeginCommandBuffer(m_recording.commandBuffer, &beginInfo);
+		return m_recording.commandBuffer;
+	}
+
+	// Begin() ŋL^R}h waits ̊Ɏs.
+	QueueSyncPoint Submit(std::span<const QueueWait> waits = {})
+	{
+		vkEndCommandBuffer(m_recording.commandBuffer);
+
+		std::vector<VkSemaphore> waitSemaphores;
+		std::vector<uint64_t> waitValues;
+		std::vector<VkPipelineStageFlags> waitStages;
+		for (auto& wait : waits)
+		{
+			waitSemaphores.push_back(wait.point.semaphore);
+			waitValues.push_back(wait.point.value);
+			waitStages.push_back(wait.stage);
+		}
+
+		m_recording.value = ++m_lastValue;
+		VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{
+			.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+			.waitSemaphoreValueCount = uint32_t(waitValues.size()),
+			.pWaitSemaphoreValues = waitValues.data(),
+			.signalSemaphoreValueCount = 1,
+			.pSignalSemaphoreValues = &m_recording.value,
+		};
+		VkSubmitInfo submitInfo{
+			.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+			.pNext = &timelineSubmitInfo,
+			.waitSemaphoreCount = uint32_t(waitSemaphores.size()),
+			.pWaitSemaphores = waitSemaphores.data(),
+			.pWaitDstStageMask = waitStages.data(),
+			.commandBufferCount = 1,
+			.pCommandBuffers = &m_recording.commandBuffer,
+			.signalSemaphoreCount = 1,
+			.pSignalSemaphores = &m_semaphore,
+		};
+		vkQueueSubmit(m_queue, 1, &submitInfo, VK_NULL_HANDLE);
+		m_inFlight.push_back(m_recording);
+		m_recording = {};
+		return QueueSyncPoint{ .semaphore = m_semaphore, .value = m_lastValue };
+	}
+
+private:
+	struct Batch
+	{
+		VkCommandPool commandPool = VK_NULL_HANDLE;
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+		uint64_t value = 0;
+	};
+
+	Batch CreateBatch()
+	{
+		Batch batch;
+		VkCommandPoolCreateInfo poolCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+			.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+			.queueFamilyIndex = m_familyIndex,
+		};
+		vkCreateCommandPool(m_device, &poolCreateInfo, nullptr, &batch.commandPool);
+		m_deletionQueue->Track(batch.commandPool);
+		VkCommandBufferAllocateInfo allocInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+			.commandPool = batch.commandPool,
+			.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+			.commandBufferCount = 1,
+		};
+		vkAllocateCommandBuffers(m_device, &allocInfo, &batch.commandBuffer);
+		return batch;
+	}
+
+	uint64_t GetCompletedValue()
+	{
+		if (m_completedValue < m_lastValue)
+		{
+			uint64_t value = 0;
+			m_getSemaphoreCounterValue(m_device, m_semaphore, &value);
+			m_completedValue = std::max(m_completedValue, value);
+		}
+		return m_completedValue;
+	}
+
+	// s̏IR}hv[ėpł悤ɖ߂.
+	void Recycle()
+	{
+		auto completed = GetCompletedValue();
+		while (!m_inFlight.empty() && m_inFlight.front().value <= completed)
+		{
+			m_freeBatches.push_back(m_inFlight.front());
+			m_inFlight.pop_front();
+		}
+	}
+
+	VkDevice m_device = VK_NULL_HANDLE;
+	DeletionQueue* m_deletionQueue = nullptr;
+	VkQueue m_queue = VK_NULL_HANDLE;
+	uint32_t m_familyIndex = 0;
+	VkSemaphore m_semaphore = VK_NULL_HANDLE;
+	PFN_vkGetSemaphoreCounterValue m_getSemaphoreCounterValue = nullptr;
+	Batch m_recording;
+	std::deque<Batch> m_inFlight;
+	std::vector<Batch> m_freeBatches;
+	uint64_t m_lastValue = 0;
+	uint64_t m_completedValue = 0;
+};
+
+// L[t@~[ԂŃ\[X̏Lڂ.
+// ̃L[ Release*()A擾̃L[ Acquire*() 𓯂ŋL^A
+// 擾͉̓ QueueSyncPoint ҂. t@~[Ȃ͕sv.
+struct QueueOwnershipTransfer
+{
+	uint32_t srcFamily;
+	uint32_t dstFamily;
+
+	bool IsNeeded() const { return srcFamily != dstFamily; }
+
+	void ReleaseBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+		VkPipelineStageFlags srcStage, VkAccessFlags srcAccess) const
+	{
+		if (!IsNeeded())
+		{
+			return;
+		}
+		auto barrier = MakeBufferBarrier(buffer, offset, size);
+		barrier.srcAccessMask = srcAccess;
+		vkCmdPipelineBarrier(commandBuffer, srcStage, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+	}
+
+	void AcquireBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+		VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) const
+	{
+		auto barrier = MakeBufferBarrier(buffer, offset, size);
+		barrier.dstAccessMask = dstAccess;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStage, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+	}
+
+private:
+	VkBufferMemoryBarrier MakeBufferBarrier(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size) const
+	{
+		return VkBufferMemoryBarrier{
+			.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+			.srcQueueFamilyIndex = IsNeeded() ? srcFamily : VK_QUEUE_FAMILY_IGNORED,
+			.dstQueueFamilyIndex = IsNeeded() ? dstFamily : VK_QUEUE_FAMILY_IGNORED,
+			.buffer = buffer,
+			.offset = offset,
+			.size = size,
+		};
+	}
+};
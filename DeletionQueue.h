@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Volk/volk.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <format>
+#include <map>
+#include <string>
+
+// fBXpb`unh^ŋʂ̂ 64bit rhO.
+static_assert(sizeof(void*) == 8, "DeletionQueue requires typed Vulkan handles (64-bit build).");
+
+// foCXLnh̎Ǘ.
+// nh Track() œo^Aj Destroy() Ńt[̒ʂԍƈꏏɗ\񂷂.
+// \񂵂nh́A̔ԍ̃t[Ƃ Flush() œ`_Ŕj.
+class DeletionQueue
+{
+public:
+	void Initialize(VkDevice device)
+	{
+		m_device = device;
+	}
+
+	// nho^. o^܂܏Iƃ[NƂĕ񍐂.
+	template<class T>
+	T Track(T handle)
+	{
+		if (handle != VK_NULL_HANDLE)
+		{
+			m_live.emplace(ToKey(handle), HandleTraits<T>::Name);
+		}
+		return handle;
+	}
+
+	// serial ̃t[ handle j. handle  VK_NULL_HANDLE ɂȂ.
+	template<class T>
+	void Destroy(T& handle, uint64_t serial)
+	{
+		if (handle == VK_NULL_HANDLE)
+		{
+			return;
+		}
+		// j̏ۂ߁Aԍ͒Pɑ.
+		m_lastSerial = std::max(m_lastSerial, serial);
+		m_pending.push_back(Entry{
+			.serial = m_lastSerial,
+			.key = ToKey(handle),
+			.destroy = [](VkDevice device, uint64_t key) { HandleTraits<T>::Destroy(device, FromKey<T>(key)); },
+		});
+		m_peakPendingCount = std::max(m_peakPendingCount, m_pending.size());
+		handle = VK_NULL_HANDLE;
+	}
+
+	// GPU gIƕĂ handle ɔj. handle  VK_NULL_HANDLE ɂȂ.
+	template<class T>
+	void DestroyNow(T& handle)
+	{
+		if (handle == VK_NULL_HANDLE)
+		{
+			return;
+		}
+		Execute(Entry{
+			.serial = 0,
+			.key = ToKey(handle),
+			.destroy = [](VkDevice device, uint64_t key) { HandleTraits<T>::Destroy(device, FromKey<T>(key)); },
+		});
+		handle = VK_NULL_HANDLE;
+	}
+
+	// completedSerial ܂ł̃t[̂ŁA܂łɗ\񂳂ꂽjs.
+	void Flush(uint64_t completedSerial)
+	{
+		while (!m_pending.empty() && m_pending.front().serial <= completedSerial)
+		{
+			Execute(m_pending.front());
+			m_pending.pop_front();
+		}
+	}
+
+	// foCXAChł邱ƂmFɌĂ.
+	void FlushAll()
+	{
+		for (auto& entry : m_pending)
+		{
+			Execute(entry);
+		}
+		m_pending.clear();
+	}
+
+	size_t GetPendingCount() const { return m_pending.size(); }
+	size_t GetPeakPendingCount() const { return m_peakPendingCount; }
+	size_t GetLiveCount() const { return m_live.size(); }
+	uint64_t GetDestroyedCount() const { return m_destroyedCount; }
+
+	// jꂸɎcĂnḧꗗ. ΋󕶎.
+	std::string ReportLeaks() const
+	{
+		std::string report;
+		for (auto& [key, name] : m_live)
+		{
+			report += std::format("  leaked {} 0x{:016x}\n", name, key);
+		}
+		return report;
+	}
+
+private:
+	template<class T> struct HandleTraits;
+
+	struct Entry
+	{
+		uint64_t serial;
+		uint64_t key;
+		void (*destroy)(VkDevice, uint64_t);
+	};
+
+	template<class T>
+	static uint64_t ToKey(T handle)
+	{
+		return uint64_t(reinterpret_cast<uintptr_t>(handle));
+	}
+	template<class T>
+	static T FromKey(uint64_t key)
+	{
+		return reinterpret_cast<T>(uintptr_t(key));
+	}
+
+	void Execute(const Entry& entry)
+	{
+		entry.destroy(m_device, entry.key);
+		// fBXpb`unh͒ld̂ŁA1菜.
+		if (auto it = m_live.find(entry.key); it != m_live.end())
+		{
+			m_live.erase(it);
+		}
+		++m_destroyedCount;
+	}
+
+	VkDevice m_device = VK_NULL_HANDLE;
+	std::deque<Entry> m_pending;
+	std::multimap<uint64_t, const char*> m_live;
+	uint64_t m_lastSerial = 0;
+	uint64_t m_destroyedCount = 0;
+	size_t m_peakPendingCount = 0;
+};
+
+// nȟ^Ƃ̖OƔj֐.
+// R}hobt@̓R}hv[ƈꏏɉ̂őΏۂɂȂ.
+#define DELETION_QUEUE_HANDLE(type, destroyFunc) \
+	template<> struct DeletionQueue::HandleTraits<type> \
+	{ \
+		static constexpr const char* Name = #type; \
+		static void Destroy(VkDevice device, type handle) { destroyFunc(device, handle, nullptr); } \
+	};
+
+DELETION_QUEUE_HANDLE(VkFence, vkDestroyFence)
+DELETION_QUEUE_HANDLE(VkSemaphore, vkDestroySemaphore)
+DELETION_QUEUE_HANDLE(VkCommandPool, vkDestroyCommandPool)
+DELETION_QUEUE_HANDLE(VkQueryPool, vkDestroyQueryPool)
+DELETION_QUEUE_HANDLE(VkBuffer, vkDestroyBuffer)
+DELETION_QUEUE_HANDLE(VkImage, vkDestroyImage)
+DELETION_QUEUE_HANDLE(VkImageView, vkDestroyImageView)
+DELETION_QUEUE_HANDLE(VkDeviceMemory, vkFreeMemory)
+DELETION_QUEUE_HANDLE(VkFramebuffer, vkDestroyFramebuffer)
+DELETION_QUEUE_HANDLE(VkRenderPass, vkDestroyRenderPass)
+DELETION_QUEUE_HANDLE(VkPipelineLayout, vkDestroyPipelineLayout)
+DELETION_QUEUE_HANDLE(VkPipeline, vkDestroyPipeline)
+DELETION_QUEUE_HANDLE(VkShaderModule, vkDestroyShaderModule)
+DELETION_QUEUE_HANDLE(VkSampler, vkDestroySampler)
+DELETION_QUEUE_HANDLE(VkDescriptorSetLayout, vkDestroyDescriptorSetLayout)
+DELETION_QUEUE_HANDLE(VkDescriptorPool, vkDestroyDescriptorPool)
+DELETION_QUEUE_HANDLE(VkSwapchainKHR, vkDestroySwapchainKHR)
+
+#undef DELETION_QUEUE_HANDLE
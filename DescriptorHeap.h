@@ -0,0 +1,333 @@
+#pragma once
+
+#include "Volk/volk.h"
+#include "DeletionQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <format>
+#include <string>
+#include <vector>
+
+// fXNv^̊Ǘ.
+// eNX`ƃobt@ update-after-bind ̑傫Ȕz (oChX̃Zbg) ̓YŎQƂA
+// Zbg̓R}hobt@ƂɈx. YvbV萔ŕ`悲Ƃɓn̂́A
+// ǂރVF[_[ƂɃpCvCCAEgƍ킹Ēǉ.
+// t[̒ŎgZbg̓t[̃XbgƂ̃v[؂oAʂɉɃv[ƃZbg.
+// `XbhĂ.
+class DescriptorHeap
+{
+public:
+	static constexpr uint32_t InvalidIndex = UINT32_MAX;
+	// oChX̃Zbg binding.
+	static constexpr uint32_t TextureBinding = 0;
+	static constexpr uint32_t BufferBinding = 1;
+
+	// bindless  false Ȃ (descriptor indexing gȂ) oChX̃ZbgȂ.
+	void Initialize(VkDevice device, VkPhysicalDevice gpu, DeletionQueue& deletionQueue, uint32_t frameCount, bool bindless)
+	{
+		m_device = device;
+		m_deletionQueue = &deletionQueue;
+		m_frames.resize(frameCount);
+		if (bindless)
+		{
+			InitializeBindless(gpu);
+		}
+	}
+
+	void Shutdown(uint64_t serial)
+	{
+		for (auto& frame : m_frames)
+		{
+			for (auto pool : frame.pools)
+			{
+				m_deletionQueue->Destroy(pool, serial);
+			}
+			frame.pools.clear();
+		}
+		m_deletionQueue->Destroy(m_bindlessPool, serial);
+		m_deletionQueue->Destroy(m_bindlessSetLayout, serial);
+	}
+
+	bool IsBindless() const { return m_bindlessSet != VK_NULL_HANDLE; }
+	VkDescriptorSetLayout GetBindlessSetLayout() const { return m_bindlessSetLayout; }
+	VkDescriptorSet GetBindlessSet() const { return m_bindlessSet; }
+
+	// `撆̃R}hobt@QƂĂĂ̂ŁA҂ɓo^ł.
+	// 󂫂 InvalidIndex Ԃ.
+	uint32_t RegisterTexture(VkImageView view, VkSampler sampler, VkImageLayout layout)
+	{
+		auto index = m_textures.Allocate();
+		if (index != InvalidIndex)
+		{
+			VkDescriptorImageInfo imageInfo{ .sampler = sampler, .imageView = view, .imageLayout = layout };
+			Write(TextureBinding, index, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &imageInfo, nullptr);
+		}
+		return index;
+	}
+
+	uint32_t RegisterBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+	{
+		auto index = m_buffers.Allocate();
+		if (index != InvalidIndex)
+		{
+			VkDescriptorBufferInfo bufferInfo{ .buffer = buffer, .offset = offset, .range = range };
+			Write(BufferBinding, index, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &bufferInfo);
+		}
+		return index;
+	}
+
+	// Y serial ̃t[Ăėp.
+	void ReleaseTexture(uint32_t index, uint64_t serial) { m_textures.Release(index, serial); }
+	void ReleaseBuffer(uint32_t index, uint64_t serial) { m_buffers.Release(index, serial); }
+
+	// frameSlot ̑O̎gpɌĂ. completedSerial ܂łɉꂽYėpł悤ɂ.
+	void BeginFrame(uint32_t frameSlot, uint64_t completedSerial)
+	{
+		m_textures.Flush(completedSerial);
+		m_buffers.Flush(completedSerial);
+
+		m_currentFrame = &m_frames[frameSlot];
+		for (size_t i = 0; i < m_currentFrame->usedPools; ++i)
+		{
+			vkResetDescriptorPool(m_device, m_currentFrame->pools[i], 0);
+		}
+		m_currentFrame->usedPools = 0;
+	}
+
+	// ݂̃t[̒ŎgZbg. ͕sv. BeginFrame() ̌ɌĂ.
+	VkDescriptorSet AllocateTransient(VkDescriptorSetLayout layout)
+	{
+		auto& frame = *m_currentFrame;
+		VkDescriptorSetAllocateInfo allocateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+			.descriptorSetCount = 1,
+			.pSetLayouts = &layout,
+		};
+		VkDescriptorSet set = VK_NULL_HANDLE;
+		if (frame.usedPools > 0)
+		{
+			allocateInfo.descriptorPool = frame.pools[frame.usedPools - 1];
+			if (vkAllocateDescriptorSets(m_device, &allocateInfo, &set) == VK_SUCCESS)
+			{
+				++m_transientSetCount;
+				return set;
+			}
+		}
+		// ȂȂ玟̃v[Ɉڂ. v[̓ZbgĎg.
+		if (frame.usedPools == frame.pools.size())
+		{
+			frame.pools.push_back(CreateTransientPool());
+		}
+		allocateInfo.descriptorPool = frame.pools[frame.usedPools++];
+		if (vkAllocateDescriptorSets(m_device, &allocateInfo, &set) != VK_SUCCESS)
+		{
+			return VK_NULL_HANDLE;
+		}
+		++m_transientSetCount;
+		return set;
+	}
+
+	std::string FormatStats() const
+	{
+		size_t poolCount = 0;
+		for (auto& frame : m_frames)
+		{
+			poolCount += frame.pools.size();
+		}
+		return std::format("Descriptors: {}, textures {}/{}, buffers {}/{}, {} transient sets in {} pools.\n",
+			IsBindless() ? "bindless" : "bindless disabled",
+			m_textures.GetUsedCount(), m_textures.capacity, m_buffers.GetUsedCount(), m_buffers.capacity,
+			m_transientSetCount, poolCount);
+	}
+
+private:
+	static constexpr uint32_t MaxTextures = 16384;
+	static constexpr uint32_t MaxBuffers = 16384;
+	static constexpr uint32_t TransientSetsPerPool = 256;
+	static constexpr uint32_t ReservedResources = 64;
+
+	// oChX̔z̓Y̊蓖. Y̓t[̊҂Ă߂.
+	struct IndexAllocator
+	{
+		uint32_t capacity = 0;
+		uint32_t next = 0;
+		std::vector<uint32_t> freeIndices;
+		std::deque<std::pair<uint64_t, uint32_t>> pending;
+
+		uint32_t Allocate()
+		{
+			if (!freeIndices.empty())
+			{
+				auto index = freeIndices.back();
+				freeIndices.pop_back();
+				return index;
+			}
+			return next < capacity ? next++ : InvalidIndex;
+		}
+		void Release(uint32_t index, uint64_t serial)
+		{
+			if (index != InvalidIndex)
+			{
+				pending.emplace_back(serial, index);
+			}
+		}
+		void Flush(uint64_t completedSerial)
+		{
+			while (!pending.empty() && pending.front().first <= completedSerial)
+			{
+				freeIndices.push_back(pending.front().second);
+				pending.pop_front();
+			}
+		}
+		uint32_t GetUsedCount() const { return next - uint32_t(freeIndices.size() + pending.size()); }
+	};
+
+	struct FramePools
+	{
+		std::vector<VkDescriptorPool> pools;
+		size_t usedPools = 0;
+	};
+
+	void InitializeBindless(VkPhysicalDevice gpu)
+	{
+		// z̑傫 update-after-bind ̏Ɏ߂.
+		VkPhysicalDeviceDescriptorIndexingProperties indexingProperties{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES,
+		};
+		VkPhysicalDeviceProperties2 properties2{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+			.pNext = &indexingProperties,
+		};
+		vkGetPhysicalDeviceProperties2(gpu, &properties2);
+		m_textures.capacity = std::min({ MaxTextures,
+			indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+			indexingProperties.maxDescriptorSetUpdateAfterBindSamplers,
+			indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+			indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers });
+		m_buffers.capacity = std::min({ MaxBuffers,
+			indexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers,
+			indexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers });
+		// 1Xe[W猩鐔̍vɂ. ̃Zbg̕cĂ.
+		auto resources = indexingProperties.maxPerStageUpdateAfterBindResources;
+		resources = resources > ReservedResources ? resources - ReservedResources : 0;
+		if (m_textures.capacity + m_buffers.capacity > resources)
+		{
+			m_textures.capacity = std::min(m_textures.capacity, resources / 2);
+			m_buffers.capacity = std::min(m_buffers.capacity, resources - m_textures.capacity);
+		}
+		if (m_textures.capacity == 0 || m_buffers.capacity == 0)
+		{
+			return;
+		}
+
+		std::array<VkDescriptorSetLayoutBinding, 2> bindings{{
+			{
+				.binding = TextureBinding,
+				.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+				.descriptorCount = m_textures.capacity,
+				.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_COMPUTE_BIT,
+			},
+			{
+				.binding = BufferBinding,
+				.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+				.descriptorCount = m_buffers.capacity,
+				.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_COMPUTE_BIT,
+			},
+		}};
+		// o^̓Y͎QƂȂOŁA܂ɂ.
+		VkDescriptorBindingFlags bindingFlag = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+			VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+		std::array<VkDescriptorBindingFlags, 2> bindingFlags{ bindingFlag, bindingFlag };
+		VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+			.bindingCount = uint32_t(bindingFlags.size()),
+			.pBindingFlags = bindingFlags.data(),
+		};
+		VkDescriptorSetLayoutCreateInfo layoutCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+			.pNext = &bindingFlagsCreateInfo,
+			.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+			.bindingCount = uint32_t(bindings.size()),
+			.pBindings = bindings.data(),
+		};
+		vkCreateDescriptorSetLayout(m_device, &layoutCreateInfo, nullptr, &m_bindlessSetLayout);
+		m_deletionQueue->Track(m_bindlessSetLayout);
+
+		std::array<VkDescriptorPoolSize, 2> poolSizes{{
+			{ .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .descriptorCount = m_textures.capacity },
+			{ .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .descriptorCount = m_buffers.capacity },
+		}};
+		VkDescriptorPoolCreateInfo poolCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+			.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+			.maxSets = 1,
+			.poolSizeCount = uint32_t(poolSizes.size()),
+			.pPoolSizes = poolSizes.data(),
+		};
+		vkCreateDescriptorPool(m_device, &poolCreateInfo, nullptr, &m_bindlessPool);
+		m_deletionQueue->Track(m_bindlessPool);
+
+		VkDescriptorSetAllocateInfo allocateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+			.descriptorPool = m_bindlessPool,
+			.descriptorSetCount = 1,
+			.pSetLayouts = &m_bindlessSetLayout,
+		};
+		if (vkAllocateDescriptorSets(m_device, &allocateInfo, &m_bindlessSet) != VK_SUCCESS)
+		{
+			m_bindlessSet = VK_NULL_HANDLE;
+		}
+	}
+
+	void Write(uint32_t binding, uint32_t index, VkDescriptorType type,
+		const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo)
+	{
+		VkWriteDescriptorSet write{
+			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			.dstSet = m_bindlessSet,
+			.dstBinding = binding,
+			.dstArrayElement = index,
+			.descriptorCount = 1,
+			.descriptorType = type,
+			.pImageInfo = imageInfo,
+			.pBufferInfo = bufferInfo,
+		};
+		vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+	}
+
+	// ʂɉȂ̂ FREE_DESCRIPTOR_SET_BIT ͕tȂ.
+	VkDescriptorPool CreateTransientPool()
+	{
+		std::array<VkDescriptorPoolSize, 4> poolSizes{{
+			{ .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .descriptorCount = TransientSetsPerPool * 2 },
+			{ .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .descriptorCount = TransientSetsPerPool * 4 },
+			{ .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .descriptorCount = TransientSetsPerPool * 4 },
+			{ .type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, .descriptorCount = TransientSetsPerPool },
+		}};
+		VkDescriptorPoolCreateInfo poolCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+			.maxSets = TransientSetsPerPool,
+			.poolSizeCount = uint32_t(poolSizes.size()),
+			.pPoolSizes = poolSizes.data(),
+		};
+		VkDescriptorPool pool;
+		vkCreateDescriptorPool(m_device, &poolCreateInfo, nullptr, &pool);
+		return m_deletionQueue->Track(pool);
+	}
+
+	VkDevice m_device = VK_NULL_HANDLE;
+	DeletionQueue* m_deletionQueue = nullptr;
+
+	VkDescriptorSetLayout m_bindlessSetLayout = VK_NULL_HANDLE;
+	VkDescriptorPool m_bindlessPool = VK_NULL_HANDLE;
+	VkDescriptorSet m_bindlessSet = VK_NULL_HANDLE;
+	IndexAllocator m_textures;
+	IndexAllocator m_buffers;
+
+	std::vector<FramePools> m_frames;
+	FramePools* m_currentFrame = nullptr;
+	uint64_t m_transientSetCount = 0;
+};
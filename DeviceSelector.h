@@ -0,0 +1,388 @@
+#pragma once
+
+#include "Volk/volk.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// foCX̓_āAgpfoCXƃL[t@~[߂.
+// K{ (OtBbNXL[Av[gAK{g) 𖞂ȂfoCX͌₩OA
+// cށAfoCX[J̗ʁAIvV@\̑ΉŔr.
+class DeviceSelector
+{
+public:
+	struct Requirements
+	{
+		// VK_NULL_HANDLE Ȃv[gvȂ (wbhX).
+		VkSurfaceKHR surface = VK_NULL_HANDLE;
+		std::vector<const char*> requiredExtensions;
+		// ΉĂΉ_g.
+		std::vector<const char*> optionalExtensions;
+		// foCẌꕔA܂ deviceUUID (16iA'-' ͖). Ȃ̓_݂̂őI.
+		std::string override;
+		// vkGetPhysicalDeviceProperties2 gĂ悢CX^X̃o[W.
+		uint32_t instanceApiVersion = VK_API_VERSION_1_0;
+	};
+
+	struct Candidate
+	{
+		VkPhysicalDevice gpu = VK_NULL_HANDLE;
+		VkPhysicalDeviceProperties properties{};
+		uint8_t deviceUUID[VK_UUID_SIZE]{};
+		bool hasDeviceUUID = false;
+		uint32_t graphicsQueueFamily = UINT32_MAX;
+		uint32_t timestampValidBits = 0;
+		// OtBbNXȂt@~[΂g.  graphicsQueueFamily.
+		uint32_t computeQueueFamily = UINT32_MAX;
+		uint32_t transferQueueFamily = UINT32_MAX;
+		std::vector<VkQueueFamilyProperties> queueFamilies;
+		uint64_t deviceLocalBytes = 0;
+		bool supportsTimelineSemaphore = false;
+		bool supportsDynamicRendering = false;
+		// update-after-bind ŕIɖ߂fXNv^̔z (oChX) g.
+		bool supportsDescriptorIndexing = false;
+		bool supportsSynchronization2 = false;
+		// v[gɔԍt (VK_KHR_present_id)A̕\҂Ă (VK_KHR_present_wait).
+		bool supportsPresentWait = false;
+		std::vector<std::string> extensions;
+		// ₩OR. Ȃgp\.
+		std::string rejectReason;
+		int64_t score = 0;
+
+		bool HasExtension(std::string_view name) const
+		{
+			return std::ranges::find(extensions, name) != extensions.end();
+		}
+	};
+
+	// gp\ȃfoCX std::nullopt.
+	std::optional<Candidate> Select(VkInstance instance, const Requirements& requirements)
+	{
+		m_candidates.clear();
+		m_decision.clear();
+
+		uint32_t count = 0;
+		vkEnumeratePhysicalDevices(instance, &count, nullptr);
+		std::vector<VkPhysicalDevice> gpus(count);
+		vkEnumeratePhysicalDevices(instance, &count, gpus.data());
+		for (auto gpu : gpus)
+		{
+			m_candidates.push_back(Evaluate(gpu, requirements));
+		}
+
+		const Candidate* best = nullptr;
+		for (auto& c : m_candidates)
+		{
+			if (c.rejectReason.empty() && (best == nullptr || c.score > best->score))
+			{
+				best = &c;
+			}
+		}
+
+		if (!requirements.override.empty())
+		{
+			auto it = std::ranges::find_if(m_candidates, [&](auto& c) { return Matches(c, requirements.override); });
+			if (it == m_candidates.end())
+			{
+				m_decision = std::format("override '{}' matched no device, ", requirements.override);
+			}
+			else if (!it->rejectReason.empty())
+			{
+				m_decision = std::format("override '{}' matched {} but it is unusable ({}), ",
+					requirements.override, it->properties.deviceName, it->rejectReason);
+			}
+			else
+			{
+				m_decision = std::format("override '{}'", requirements.override);
+				return *it;
+			}
+		}
+		if (best == nullptr)
+		{
+			m_decision += "no usable device";
+			return std::nullopt;
+		}
+		m_decision += "highest score";
+		return *best;
+	}
+
+	// e̍̓_ʂƑI𗝗R (Oo͗p).
+	std::string Report(const Candidate* selected) const
+	{
+		std::string report;
+		for (uint32_t i = 0; auto& c : m_candidates)
+		{
+			report += std::format("GPU {}: {} ({}, {} MiB device local, UUID {}) ",
+				i++, c.properties.deviceName, GetTypeName(c.properties.deviceType),
+				c.deviceLocalBytes >> 20, c.hasDeviceUUID ? FormatUUID(c.deviceUUID) : "n/a");
+			report += c.rejectReason.empty() ? std::format("score {}\n", c.score) : std::format("rejected: {}\n", c.rejectReason);
+		}
+		if (selected != nullptr)
+		{
+			report += std::format("Selected GPU: {} (queue family graphics {}, compute {}, transfer {}, {})\n",
+				selected->properties.deviceName, selected->graphicsQueueFamily,
+				selected->computeQueueFamily, selected->transferQueueFamily, m_decision);
+		}
+		else
+		{
+			report += std::format("Selected GPU: none ({})\n", m_decision);
+		}
+		return report;
+	}
+
+	static std::string FormatUUID(const uint8_t (&uuid)[VK_UUID_SIZE])
+	{
+		std::string str;
+		for (int i = 0; i < VK_UUID_SIZE; ++i)
+		{
+			str += std::format("{:02x}", uuid[i]);
+			if (i == 3 || i == 5 || i == 7 || i == 9)
+			{
+				str += '-';
+			}
+		}
+		return str;
+	}
+
+private:
+	Candidate Evaluate(VkPhysicalDevice gpu, const Requirements& requirements) const
+	{
+		Candidate c{ .gpu = gpu };
+		vkGetPhysicalDeviceProperties(gpu, &c.properties);
+		auto apiVersion = std::min(c.properties.apiVersion, requirements.instanceApiVersion);
+
+		if (apiVersion >= VK_API_VERSION_1_1)
+		{
+			VkPhysicalDeviceIDProperties idProperties{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES,
+			};
+			VkPhysicalDeviceProperties2 properties2{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+				.pNext = &idProperties,
+			};
+			vkGetPhysicalDeviceProperties2(gpu, &properties2);
+			std::copy_n(idProperties.deviceUUID, VK_UUID_SIZE, c.deviceUUID);
+			c.hasDeviceUUID = true;
+		}
+
+		uint32_t extensionCount = 0;
+		vkEnumerateDeviceExtensionProperties(gpu, nullptr, &extensionCount, nullptr);
+		std::vector<VkExtensionProperties> extensions(extensionCount);
+		vkEnumerateDeviceExtensionProperties(gpu, nullptr, &extensionCount, extensions.data());
+		for (auto& e : extensions)
+		{
+			c.extensions.emplace_back(e.extensionName);
+		}
+
+		VkPhysicalDeviceMemoryProperties memoryProperties;
+		vkGetPhysicalDeviceMemoryProperties(gpu, &memoryProperties);
+		for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i)
+		{
+			if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+			{
+				c.deviceLocalBytes += memoryProperties.memoryHeaps[i].size;
+			}
+		}
+
+		// OtBbNXƃv[g𓯂L[ōŝŁAɑΉt@~[T.
+		uint32_t familyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(gpu, &familyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> families(familyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(gpu, &familyCount, families.data());
+		c.queueFamilies = families;
+		bool hasGraphics = false;
+		for (uint32_t i = 0; i < familyCount; ++i)
+		{
+			if ((families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) == 0)
+			{
+				continue;
+			}
+			hasGraphics = true;
+			VkBool32 supportsPresent = VK_TRUE;
+			if (requirements.surface != VK_NULL_HANDLE)
+			{
+				vkGetPhysicalDeviceSurfaceSupportKHR(gpu, i, requirements.surface, &supportsPresent);
+			}
+			if (supportsPresent)
+			{
+				c.graphicsQueueFamily = i;
+				c.timestampValidBits = families[i].timestampValidBits;
+				break;
+			}
+		}
+		if (!hasGraphics)
+		{
+			c.rejectReason = "no graphics queue";
+			return c;
+		}
+		if (c.graphicsQueueFamily == UINT32_MAX)
+		{
+			c.rejectReason = "cannot present to the surface";
+			return c;
+		}
+		c.computeQueueFamily = FindQueueFamily(families, VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT, c.graphicsQueueFamily);
+		// ]pΔ񓯊Rs[g̃t@~[œ].
+		c.transferQueueFamily = FindQueueFamily(families, VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT, c.computeQueueFamily);
+
+		for (auto name : requirements.requiredExtensions)
+		{
+			if (!c.HasExtension(name))
+			{
+				c.rejectReason = std::format("missing {}", name);
+				return c;
+			}
+		}
+
+		// g@\̈ˑ֌W𖞂߁AVK_KHR_dynamic_rendering  Vulkan 1.2 ȏłg.
+		bool queryTimeline = apiVersion >= VK_API_VERSION_1_2 ||
+			(apiVersion >= VK_API_VERSION_1_1 && c.HasExtension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME));
+		bool queryDynamicRendering = apiVersion >= VK_API_VERSION_1_3 ||
+			(apiVersion >= VK_API_VERSION_1_2 && c.HasExtension(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME));
+		bool queryDescriptorIndexing = apiVersion >= VK_API_VERSION_1_2 ||
+			(apiVersion >= VK_API_VERSION_1_1 && c.HasExtension(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME));
+		bool querySynchronization2 = apiVersion >= VK_API_VERSION_1_3 ||
+			(apiVersion >= VK_API_VERSION_1_1 && c.HasExtension(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME));
+		bool queryPresentWait = requirements.surface != VK_NULL_HANDLE && apiVersion >= VK_API_VERSION_1_1 &&
+			c.HasExtension(VK_KHR_PRESENT_ID_EXTENSION_NAME) && c.HasExtension(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+		if (queryTimeline || queryDynamicRendering || queryDescriptorIndexing || querySynchronization2 || queryPresentWait)
+		{
+			VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES,
+			};
+			VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES,
+			};
+			VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES,
+			};
+			VkPhysicalDeviceSynchronization2Features synchronization2Features{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES,
+			};
+			VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+			};
+			VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR,
+			};
+			VkPhysicalDeviceFeatures2 features2{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+			};
+			if (queryTimeline)
+			{
+				timelineFeatures.pNext = features2.pNext;
+				features2.pNext = &timelineFeatures;
+			}
+			if (queryDynamicRendering)
+			{
+				dynamicRenderingFeatures.pNext = features2.pNext;
+				features2.pNext = &dynamicRenderingFeatures;
+			}
+			if (queryDescriptorIndexing)
+			{
+				descriptorIndexingFeatures.pNext = features2.pNext;
+				features2.pNext = &descriptorIndexingFeatures;
+			}
+			if (querySynchronization2)
+			{
+				synchronization2Features.pNext = features2.pNext;
+				features2.pNext = &synchronization2Features;
+			}
+			if (queryPresentWait)
+			{
+				presentIdFeatures.pNext = features2.pNext;
+				presentWaitFeatures.pNext = &presentIdFeatures;
+				features2.pNext = &presentWaitFeatures;
+			}
+			vkGetPhysicalDeviceFeatures2(gpu, &features2);
+			c.supportsTimelineSemaphore = timelineFeatures.timelineSemaphore == VK_TRUE;
+			c.supportsDynamicRendering = dynamicRenderingFeatures.dynamicRendering == VK_TRUE;
+			c.supportsSynchronization2 = synchronization2Features.synchronization2 == VK_TRUE;
+			c.supportsPresentWait = presentIdFeatures.presentId == VK_TRUE && presentWaitFeatures.presentWait == VK_TRUE;
+			c.supportsDescriptorIndexing = descriptorIndexingFeatures.runtimeDescriptorArray == VK_TRUE &&
+				descriptorIndexingFeatures.descriptorBindingPartiallyBound == VK_TRUE &&
+				descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending == VK_TRUE &&
+				descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE &&
+				descriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind == VK_TRUE &&
+				descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing == VK_TRUE;
+		}
+
+		// ނ̍ł傫悤ɂAނ̒ł̓ʂƃIvV@\Ŕׂ.
+		c.score = GetTypeScore(c.properties.deviceType);
+		c.score += int64_t(c.deviceLocalBytes >> 20);
+		c.score += c.supportsTimelineSemaphore ? 1000 : 0;
+		for (auto name : requirements.optionalExtensions)
+		{
+			c.score += c.HasExtension(name) ? 1000 : 0;
+		}
+		return c;
+	}
+
+	// required  excluded Ȃt@~[̂Aŏ̂̂Ԃ.  fallback.
+	static uint32_t FindQueueFamily(const std::vector<VkQueueFamilyProperties>& families,
+		VkQueueFlags required, VkQueueFlags excluded, uint32_t fallback)
+	{
+		for (uint32_t i = 0; i < uint32_t(families.size()); ++i)
+		{
+			if ((families[i].queueFlags & required) == required && (families[i].queueFlags & excluded) == 0)
+			{
+				return i;
+			}
+		}
+		return fallback;
+	}
+
+	static int64_t GetTypeScore(VkPhysicalDeviceType type)
+	{
+		switch (type)
+		{
+		case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: return 1'000'000;
+		case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return 500'000;
+		case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: return 250'000;
+		// \tgEFA. GPU  CI ł͂ꂪI΂.
+		case VK_PHYSICAL_DEVICE_TYPE_CPU: return 100'000;
+		default: return 0;
+		}
+	}
+
+	static const char* GetTypeName(VkPhysicalDeviceType type)
+	{
+		switch (type)
+		{
+		case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: return "discrete";
+		case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return "integrated";
+		case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: return "virtual";
+		case VK_PHYSICAL_DEVICE_TYPE_CPU: return "cpu";
+		default: return "other";
+		}
+	}
+
+	// UUID ̊SvA܂̓foCX̕v (啶ʂȂ).
+	static bool Matches(const Candidate& c, const std::string& pattern)
+	{
+		auto normalize = [](std::string_view s, bool uuid) {
+			std::string out;
+			for (char ch : s)
+			{
+				if (!uuid || ch != '-')
+				{
+					out += char(std::tolower(static_cast<unsigned char>(ch)));
+				}
+			}
+			return out;
+		};
+		if (c.hasDeviceUUID && normalize(pattern, true) == normalize(FormatUUID(c.deviceUUID), true))
+		{
+			return true;
+		}
+		return normalize(c.properties.deviceName, false).find(normalize(pattern, false)) != std::string::npos;
+	}
+
+	std::vector<Candidate> m_candidates;
+	std::string m_decision;
+};
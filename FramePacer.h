@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <thread>
+
+// t[̊Jn (͂ǂގ_) ̊Ԋuɑt[[g.
+// OS ̃X[v͋N̂x邱Ƃ̂ŁȀO܂ŖAc͋ő҂.
+// 肷钷́A܂łɊϑX[v̒x̍ől (XɌ) ɍ킹.
+// `XbhĂ.
+class FramePacer
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	// frameRateLimit  0 ȉȂ琧Ȃ.
+	void Initialize(double frameRateLimit)
+	{
+		m_period = frameRateLimit > 0.0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frameRateLimit)) : Clock::duration::zero();
+		m_spinMargin = InitialSpinMargin;
+		m_deadline = {};
+	}
+
+	bool IsLimiting() const { return m_period > Clock::duration::zero(); }
+
+	// Õt[̊Jn 1 o܂ő҂A҂ (~b) Ԃ.
+	double WaitForNextFrame()
+	{
+		if (!IsLimiting())
+		{
+			return 0.0;
+		}
+		auto start = Clock::now();
+		// ƁA1 ȏxꂽꍇ͊蒼. x߂Ƒĕ`悷邱Ƃ͂Ȃ.
+		if (m_deadline == Clock::time_point{} || start - m_deadline > m_period)
+		{
+			if (m_deadline != Clock::time_point{})
+			{
+				++m_missedCount;
+			}
+			m_deadline = start + m_period;
+			++m_frameCount;
+			return 0.0;
+		}
+
+		auto wakeTime = m_deadline - m_spinMargin;
+		if (start < wakeTime)
+		{
+			std::this_thread::sleep_until(wakeTime);
+			auto oversleep = Clock::now() - wakeTime;
+			m_spinMargin = std::min(std::max(oversleep + MinSpinMargin, DecayMargin(m_spinMargin)), m_period);
+		}
+		auto spinStart = Clock::now();
+		while (Clock::now() < m_deadline)
+		{
+			std::this_thread::yield();
+		}
+		auto end = Clock::now();
+
+		auto waitMs = std::chrono::duration<double, std::milli>(end - start).count();
+		++m_frameCount;
+		m_totalWaitMs += waitMs;
+		m_totalSpinMs += std::chrono::duration<double, std::milli>(end - spinStart).count();
+		m_maxLateMs = std::max(m_maxLateMs, std::chrono::duration<double, std::milli>(end - m_deadline).count());
+		m_deadline += m_period;
+		return waitMs;
+	}
+
+	// Xbv`FC̍蒼Ȃǂ̒~̌ŌĂ. ̃t[蒼.
+	void Reset()
+	{
+		m_deadline = {};
+	}
+
+	std::string FormatStats() const
+	{
+		if (!IsLimiting() || m_frameCount == 0)
+		{
+			return {};
+		}
+		return std::format("Frame limiter: {:.2f} ms period, {} frames, mean wait {:.3f} ms (spin {:.3f} ms), max late {:.3f} ms, {} missed\n",
+			std::chrono::duration<double, std::milli>(m_period).count(), m_frameCount,
+			m_totalWaitMs / double(m_frameCount), m_totalSpinMs / double(m_frameCount), m_maxLateMs, m_missedCount);
+	}
+
+private:
+	static constexpr Clock::duration MinSpinMargin = std::chrono::microseconds(200);
+	static constexpr Clock::duration InitialSpinMargin = std::chrono::milliseconds(2);
+
+	// ꎞIɑ傫xꂽA𒷂Ȃ悤ɏk߂.
+	static Clock::duration DecayMargin(Clock::duration margin)
+	{
+		return margin - margin / 64;
+	}
+
+	Clock::duration m_period{};
+	Clock::duration m_spinMargin = InitialSpinMargin;
+	Clock::time_point m_deadline;
+
+	uint64_t m_frameCount = 0;
+	uint64_t m_missedCount = 0;
+	double m_totalWaitMs = 0.0;
+	double m_totalSpinMs = 0.0;
+	double m_maxLateMs = 0.0;
+};
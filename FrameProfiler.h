@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "SpscRingBuffer.h"
+
+// 1t[̌v. Ԃׂ͂ă~b.
+struct FrameTimings
+{
+	uint64_t frameNumber = 0;
+	// v̉ʃ[hƃv[g[h(ÓIȕw).
+	const char* displayMode = "";
+	const char* presentMode = "";
+
+	double frameMs = 0.0;
+	double fenceWaitMs = 0.0;
+	double acquireMs = 0.0;
+	double recordMs = 0.0;
+	double submitMs = 0.0;
+	double presentMs = 0.0;
+	// _[pXGPUs. ̒l͌vłȂƂ.
+	double gpuMs = -1.0;
+	// `𑜓x̔{.
+	float renderScale = 1.0f;
+	// t[[g̐ƒx[hŁA͂ǂޑOɑ҂.
+	double pacingWaitMs = 0.0;
+	// ͂ǂłTu~bgI܂.
+	double inputLatencyMs = 0.0;
+};
+
+// t[Ƃ̌vʂW߁ACSV/JSON ւ̏o͂ƕSʐɂWvs.
+// Push() ͕`惋[vACollect() ȍ~͓ǂݏõXbhĂ.
+class FrameProfiler
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static double ElapsedMs(Clock::time_point begin, Clock::time_point end)
+	{
+		return std::chrono::duration<double, std::milli>(end - begin).count();
+	}
+
+	void Push(const FrameTimings& timings)
+	{
+		if (!m_ring.Push(timings))
+		{
+			// ǂݏoǂĂȂ. `~߂Ȃ悤Ɏ̂Ă.
+			m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	// Oobt@ɗ܂ʂ𗚗Ɉڂ.
+	void Collect()
+	{
+		FrameTimings timings;
+		while (m_ring.Pop(timings))
+		{
+			m_history.push_back(timings);
+		}
+	}
+
+	const std::vector<FrameTimings>& GetHistory() const
+	{
+		return m_history;
+	}
+	uint64_t GetDroppedCount() const
+	{
+		return m_droppedCount.load(std::memory_order_relaxed);
+	}
+
+	bool WriteCsv(const std::string& path) const
+	{
+		std::ofstream file(path, std::ios::trunc);
+		if (!file)
+		{
+			return false;
+		}
+		file << "frame,display_mode,present_mode,frame_ms,fence_wait_ms,acquire_ms,record_ms,submit_ms,present_ms,gpu_ms,render_scale,pacing_wait_ms,input_latency_ms\n";
+		for (auto& t : m_history)
+		{
+			file << std::format("{},{},{},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{:.2f},{:.4f},{:.4f}\n",
+				t.frameNumber, t.displayMode, t.presentMode,
+				t.frameMs, t.fenceWaitMs, t.acquireMs, t.recordMs, t.submitMs, t.presentMs, t.gpuMs, t.renderScale,
+				t.pacingWaitMs, t.inputLatencyMs);
+		}
+		return bool(file);
+	}
+
+	bool WriteJson(const std::string& path) const
+	{
+		std::ofstream file(path, std::ios::trunc);
+		if (!file)
+		{
+			return false;
+		}
+		file << std::format("{{\n  \"dropped\": {},\n  \"frames\": [\n", GetDroppedCount());
+		for (size_t i = 0; i < m_history.size(); ++i)
+		{
+			auto& t = m_history[i];
+			file << std::format("    {{ \"frame\": {}, \"display_mode\": \"{}\", \"present_mode\": \"{}\", "
+				"\"frame_ms\": {:.4f}, \"fence_wait_ms\": {:.4f}, \"acquire_ms\": {:.4f}, \"record_ms\": {:.4f}, "
+				"\"submit_ms\": {:.4f}, \"present_ms\": {:.4f}, \"gpu_ms\": {:.4f}, \"render_scale\": {:.2f}, "
+				"\"pacing_wait_ms\": {:.4f}, \"input_latency_ms\": {:.4f} }}{}\n",
+				t.frameNumber, t.displayMode, t.presentMode,
+				t.frameMs, t.fenceWaitMs, t.acquireMs, t.recordMs, t.submitMs, t.presentMs, t.gpuMs, t.renderScale,
+				t.pacingWaitMs, t.inputLatencyMs,
+				(i + 1 < m_history.size()) ? "," : "");
+		}
+		file << "  ]\n}\n";
+		return bool(file);
+	}
+
+	// ʃ[hƂ p50/p99/p99.9 ܂Ƃ߂.
+	std::string BuildSummary() const
+	{
+		std::map<std::string, std::vector<const FrameTimings*>> groups;
+		for (auto& t : m_history)
+		{
+			groups[t.displayMode].push_back(&t);
+		}
+
+		std::string summary;
+		for (auto& [mode, frames] : groups)
+		{
+			summary += std::format("[{}] {} frames\n", mode, frames.size());
+			summary += FormatPercentiles("frame", frames, &FrameTimings::frameMs);
+			summary += FormatPercentiles("acquire", frames, &FrameTimings::acquireMs);
+			summary += FormatPercentiles("fence wait", frames, &FrameTimings::fenceWaitMs);
+			summary += FormatPercentiles("record", frames, &FrameTimings::recordMs);
+			summary += FormatPercentiles("submit", frames, &FrameTimings::submitMs);
+			summary += FormatPercentiles("present", frames, &FrameTimings::presentMs);
+			summary += FormatPercentiles("gpu", frames, &FrameTimings::gpuMs);
+			summary += FormatPercentiles("pacing wait", frames, &FrameTimings::pacingWaitMs);
+			summary += FormatPercentiles("input to submit", frames, &FrameTimings::inputLatencyMs);
+		}
+		if (auto dropped = GetDroppedCount(); dropped > 0)
+		{
+			summary += std::format("{} frames dropped from the profile.\n", dropped);
+		}
+		return summary;
+	}
+
+	// ɕ񂾒lŋߐڏʖ@ŕSʐ߂.
+	static double Percentile(const std::vector<double>& sorted, double percent)
+	{
+		if (sorted.empty())
+		{
+			return 0.0;
+		}
+		auto rank = size_t(std::ceil(percent / 100.0 * double(sorted.size())));
+		return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+	}
+
+private:
+	static std::string FormatPercentiles(const char* label, const std::vector<const FrameTimings*>& frames, double FrameTimings::* member)
+	{
+		std::vector<double> values;
+		values.reserve(frames.size());
+		for (auto t : frames)
+		{
+			// vłȂl()͏.
+			if (t->*member >= 0.0)
+			{
+				values.push_back(t->*member);
+			}
+		}
+		if (values.empty())
+		{
+			return {};
+		}
+		std::sort(values.begin(), values.end());
+		return std::format("  {:<10} p50 {:8.3f} ms  p99 {:8.3f} ms  p99.9 {:8.3f} ms  max {:8.3f} ms\n",
+			label, Percentile(values, 50.0), Percentile(values, 99.0), Percentile(values, 99.9), values.back());
+	}
+
+	// 4096t[. I Collect() ΈȂ.
+	SpscRingBuffer<FrameTimings, 4096> m_ring;
+	std::atomic<uint64_t> m_droppedCount{ 0 };
+	std::vector<FrameTimings> m_history;
+};
@@ -0,0 +1,3095 @@
+#pragma once
+
+#define VK_NO_PROTOTYPES    // volkgp邽߂̒`
+
+// volk CN[h.
+//  VOLK_IMPLEMENTATION `|P (main.cpp, benchmark.cpp) Ɋ܂߂.
+// OS ŗL̊g@\ Platform*.cpp ň̂ŁAł VK_USE_PLATFORM_* `Ȃ.
+#include "Volk/volk.h"
+
+#include "GLFW/glfw3.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <thread>
+#include <utility>
+
+// RpCς݂̃VF[_[wb_t@Cɂ.
+#include "vertexShader.h"
+#include "fragementShader.h"
+#include "instanceVertexShader.h"
+
+#include "FrameProfiler.h"
+#include "PipelineCache.h"
+#include "DeletionQueue.h"
+#include "JobSystem.h"
+#include "DeviceSelector.h"
+#include "AsyncQueue.h"
+#include "GpuAllocator.h"
+#include "UploadRing.h"
+#include "ObjectRenderer.h"
+#include "ShaderLibrary.h"
+#include "PipelineManager.h"
+#include "Platform.h"
+#include "PresentRecovery.h"
+#include "DescriptorHeap.h"
+#include "ResolutionScaler.h"
+#include "RenderGraph.h"
+#include "FramePacer.h"
+
+// ̃TvŐ؂ւΏۂƂv[g[h.
+inline constexpr std::array<std::pair<VkPresentModeKHR, const char*>, 4> PresentModeNames{{
+	{ VK_PRESENT_MODE_IMMEDIATE_KHR, "immediate" },
+	{ VK_PRESENT_MODE_MAILBOX_KHR, "mailbox" },
+	{ VK_PRESENT_MODE_FIFO_KHR, "fifo" },
+	{ VK_PRESENT_MODE_FIFO_RELAXED_KHR, "fifo_relaxed" },
+}};
+
+inline const char* GetPresentModeName(VkPresentModeKHR mode)
+{
+	for (auto& [m, name] : PresentModeNames)
+	{
+		if (m == mode)
+		{
+			return name;
+		}
+	}
+	return "unknown";
+}
+
+class FullscreenExclusiveApp
+{
+private:
+	struct FrameInfo;
+	struct WorkerCommandPool;
+	struct FramePacingStats;
+	struct RenderCommand;
+	enum Mode {
+		Windowed,
+		BorderlessFullscreen,
+		ExclusiveFullscreen,
+	};
+	static void KeyProcessCallback(GLFWwindow* window, int, int, int, int);
+	static void WindowSizeCallback(GLFWwindow* window, int width, int height);
+	static void WindowFocusCallback(GLFWwindow* window, int focused);
+public:
+	static constexpr uint32_t MaxFramesInFlight = 8;
+
+	// N̐ݒ.
+	struct AppSettings
+	{
+		// ɏ(CPUL^GPUsd˂)t[.
+		uint32_t framesInFlight = 2;
+
+		// EBhET[tFXg킸AItXN[C[Wɕ`悷.
+		bool headless = false;
+		// wbhX쎞̕`𑜓x.
+		uint32_t width = 1280;
+		uint32_t height = 720;
+
+		// `悷t[. 0 ȂEBhE܂ő.
+		uint64_t frameCount = 0;
+
+		// Xbv`FC (wbhXł̓ItXN[C[W) ̖. 0 Ȃ玩Ō߂.
+		uint32_t swapchainImageCount = 0;
+
+		// w肵t[Ƃɉʃ[h EBhE  {[_[X  r ̏ɐ؂ւ (׎p).
+		uint32_t modeSwitchInterval = 0;
+
+		// v[g[h̗D揇. T|[gĂȂ FIFO g.
+		std::vector<VkPresentModeKHR> presentModes = { VK_PRESENT_MODE_FIFO_KHR };
+
+		// t[Ƃ̌vʂ̏o͐. Ȃo͂Ȃ.
+		std::string profileCsvPath;
+		std::string profileJsonPath;
+
+		// pCvCLbV̕ۑ. ȂfBXNɕۑȂ.
+		std::string pipelineCachePath = "pipeline_cache.bin";
+
+		// R}hL^郏[J[Xbh̐. 0 Ȃ烁CXbhŋL^.
+		uint32_t recordThreads = 0;
+		// 1t[Ŕsh[R[ (L^ׂ̊mFp).
+		uint32_t drawCount = 1;
+
+		// gpł΃^CCZ}tHŃt[̊҂. false ȂtFXg.
+		bool useTimelineSemaphore = true;
+
+		// gp GPU ̖Öꕔ܂ UUID. Ȃ玩őI.
+		std::string gpuOverride;
+
+		// p̃Rs[gE]L[ (^CCZ}tHKv).
+		bool useAsyncQueues = true;
+
+		// GPU 쓮ŕ`悷IuWFNg̐. 0 Ȃ`悵Ȃ.
+		uint32_t objectCount = 0;
+
+		// gpł VK_KHR_dynamic_rendering ŕ`悵A_[pXƃt[obt@Ȃ.
+		bool useDynamicRendering = true;
+
+		// gpł descriptor indexing ŃeNX`ƃobt@oChX̔z񂩂QƂ.
+		bool useBindless = true;
+
+		// .spv ǂݍ݁AXVĎfBNg. Ȃgݍ݂̃VF[_[g.
+		std::string shaderDirectory = "shaders";
+
+		// pɃv[ǧʂ֒Q (PresentRecovery::ParseFaults() ̌`).
+		std::string faultInjection;
+
+		// c̕`𑜓x̔{. 1 ȂkC[Wɕ`悵AXbv`FC̃C[W֊g傷.
+		float renderScale = 1.0f;
+		// frameBudgetMs ȂAGPU Ԃ̗\ZɎ܂悤{ minRenderScale  1 ̊ԂŒ.
+		float minRenderScale = 0.5f;
+		double frameBudgetMs = 0.0;
+
+		// łȂ΁ARpC_[Ot (pXEoAEꎞC[W̔zu) ̃t@Cɏo.
+		std::string renderGraphDumpPath;
+
+		// ȂAt[̊Jn (͂ǂގ_)  fps ̊Ԋuɑ.
+		double frameRateLimit = 0.0;
+		// ͂ǂޑOɑÕt[̕\ (present wait gȂ GPU ł̊) ҂A͂Tu~bg܂łZ.
+		bool lowLatency = false;
+	};
+
+	bool Initialize(const AppSettings& settings)
+	{
+		m_framesInFlight = std::clamp(settings.framesInFlight, 1u, MaxFramesInFlight);
+
+		m_headless = settings.headless;
+		m_headlessExtent = { settings.width, settings.height };
+		m_frameLimit = settings.frameCount;
+		m_swapchainImageCount = settings.swapchainImageCount;
+		m_modeSwitchInterval = settings.modeSwitchInterval;
+		m_presentModePreference = settings.presentModes;
+		m_profileCsvPath = settings.profileCsvPath;
+		m_profileJsonPath = settings.profileJsonPath;
+		m_pipelineCachePath = settings.pipelineCachePath;
+		m_drawCount = std::max(settings.drawCount, 1u);
+		m_startTime = FrameProfiler::Clock::now();
+		m_useTimeline = settings.useTimelineSemaphore;
+		m_gpuOverride = settings.gpuOverride;
+		m_useAsyncQueues = settings.useAsyncQueues;
+		m_objectCount = settings.objectCount;
+		m_shaderDirectory = settings.shaderDirectory;
+		m_useDynamicRendering = settings.useDynamicRendering;
+		m_useBindless = settings.useBindless;
+		m_renderGraphDumpPath = settings.renderGraphDumpPath;
+		m_framePacer.Initialize(settings.frameRateLimit);
+		m_lowLatency = settings.lowLatency;
+		m_resolutionScaler.Initialize(settings.renderScale, settings.minRenderScale, settings.frameBudgetMs);
+		m_scaledRendering = m_resolutionScaler.GetScale() < 1.0f || m_resolutionScaler.IsDynamic();
+		if (!m_recovery.ParseFaults(settings.faultInjection))
+		{
+			auto str = std::format("Ignored invalid fault injection entries in '{}'.\n", settings.faultInjection);
+			OutputLog(str.c_str());
+		}
+
+		if (!m_headless && !InitializeWindow())
+		{
+			return false;
+		}
+
+		if (!InitializeVulkanInstance())
+		{
+			return false;
+		}
+
+		if (!m_headless)
+		{
+			if (glfwCreateWindowSurface(m_vkInstance, m_window, nullptr, &m_surface) != VK_SUCCESS)
+			{
+				return false;
+			}
+		}
+
+		if (!InitializeVulkanDevice())
+		{
+			return false;
+		}
+		if (m_scaledRendering && !SupportsScaledRendering())
+		{
+			OutputLog("Render scale: blit to the swapchain is not supported, disabled.\n");
+			m_scaledRendering = false;
+		}
+		if (m_scaledRendering)
+		{
+			auto str = std::format("Render scale: {:.2f}{}\n", m_resolutionScaler.GetScale(),
+				m_resolutionScaler.IsDynamic() ? std::format(" (dynamic, budget {:.2f} ms)", m_resolutionScaler.GetBudgetMs()) : "");
+			OutputLog(str.c_str());
+		}
+
+		m_deletionQueue.Initialize(m_vkDevice);
+		m_gpuAllocator.Initialize(m_vkDevice, m_gpu, m_deletionQueue);
+		if (!m_uploadRing.Initialize(m_vkDevice, m_gpu, m_gpuAllocator, m_deletionQueue,
+			UploadRingSizePerFrame, m_framesInFlight, sizeof(FrameConstants)))
+		{
+			OutputLog("Upload ring: no host-visible memory, disabled.\n");
+		}
+		m_descriptorHeap.Initialize(m_vkDevice, m_gpu, m_deletionQueue, m_framesInFlight, m_useBindless);
+		m_renderGraph.Initialize(m_vkDevice, m_gpuAllocator, m_deletionQueue, m_cmdPipelineBarrier2);
+		if (m_useTimeline)
+		{
+			VkSemaphoreTypeCreateInfo semaphoreTypeInfo{
+				.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+				.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+				.initialValue = 0,
+			};
+			VkSemaphoreCreateInfo semaphoreCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+				.pNext = &semaphoreTypeInfo,
+			};
+			vkCreateSemaphore(m_vkDevice, &semaphoreCreateInfo, nullptr, &m_timelineSemaphore);
+			m_deletionQueue.Track(m_timelineSemaphore);
+		}
+		OutputLog(m_useTimeline ? "Sync: timeline semaphore\n" : "Sync: fence\n");
+		if (m_useAsyncQueues)
+		{
+			m_computeQueue.Initialize(m_vkDevice, m_deletionQueue, m_computeQueueFamily, m_computeQueueIndex, m_getSemaphoreCounterValue);
+			m_transferQueue.Initialize(m_vkDevice, m_deletionQueue, m_transferQueueFamily, m_transferQueueIndex, m_getSemaphoreCounterValue);
+			auto str = std::format("Queues: graphics {}, compute {}:{}{}, transfer {}:{}{}\n", m_graphicsQueueIndex,
+				m_computeQueueFamily, m_computeQueueIndex, m_computeQueueFamily != m_graphicsQueueIndex ? " (dedicated)" : "",
+				m_transferQueueFamily, m_transferQueueIndex, m_transferQueueFamily != m_graphicsQueueIndex ? " (dedicated)" : "");
+			OutputLog(str.c_str());
+		}
+		else
+		{
+			OutputLog("Queues: graphics only\n");
+		}
+		m_pipelineCache.Initialize(m_vkDevice, m_gpu, m_pipelineCachePath);
+		{
+			auto str = std::format("Pipeline cache: {} ({}).\n", m_pipelineCachePath, m_pipelineCache.GetStatus());
+			OutputLog(str.c_str());
+		}
+
+		// t@CVF[_[̓wb_ɖߍ񂾂̂g.
+		m_shaderLibrary.Initialize(m_vkDevice, m_shaderDirectory);
+		m_shaderLibrary.Register("shader.vert.spv", gVS, sizeof(gVS));
+		m_shaderLibrary.Register("shader.frag.spv", gFS, sizeof(gFS));
+		m_shaderLibrary.Register("instance.vert.spv", gInstanceVS, sizeof(gInstanceVS));
+		m_pipelineManager.Initialize(m_vkDevice, m_shaderLibrary, m_pipelineCache.GetHandle(), m_deletionQueue, PipelineCompileThreads);
+
+		// [J[Ƃ̃R}hv[mۂ邽߁At[̃\[XɋNĂ.
+		m_jobSystem.Initialize(settings.recordThreads);
+
+		// t[Ƃ̃\[X̓Xbv`FC̃C[WƂ͓ƗĊmۂ.
+		m_frames.resize(m_framesInFlight);
+		for (auto& frame : m_frames)
+		{
+			InitPerFrame(frame);
+		}
+		m_frameIndex = 0;
+
+		if (!InitializeSwapchain())
+		{
+			return false;
+		}
+		InitializeRenderPass();
+		InitializePipeline();
+		InitializeObjects();
+		InitializeFramebuffers();
+
+		// pCvC̓[J[ō蒼At[̋ڂōւ.
+		m_shaderLibrary.StartWatching([this](const std::vector<std::string>& names) {
+			for (auto& name : names)
+			{
+				auto str = std::format("Shader reload: {}\n", name);
+				OutputLog(str.c_str());
+			}
+			m_pipelineManager.Invalidate(names);
+		});
+		{
+			auto str = std::format("Shaders: {}\n", m_shaderLibrary.IsWatching() ? std::format("{} (hot reload)", m_shaderDirectory) : std::string("embedded"));
+			OutputLog(str.c_str());
+		}
+		return true;
+	}
+
+	void Run()
+	{
+		if (!m_window)
+		{
+			RenderLoop();
+			return;
+		}
+
+		// GLFW ̃Cxg̓CXbhōsKv̂ŁA`͐p̃Xbhōs.
+		// ͂EBhEX^C̕ύX̓R}hƂĕ`XbhɓnAt[̏~߂Ȃ.
+		m_renderThreadExited = false;
+		std::thread renderThread([this]() {
+			RenderLoop();
+			m_renderThreadExited = true;
+			glfwPostEmptyEvent();
+		});
+
+		bool quitRequested = false;
+		while (!m_renderThreadExited)
+		{
+			glfwWaitEvents();
+
+			// `XbhXbv`FC蒼ŁAEBhẼX^CύX.
+			Mode mode;
+			while (m_windowUpdates.Pop(mode))
+			{
+				UpdateApplicationWindow(mode);
+				PushRenderCommand({ .type = RenderCommand::WindowUpdated, .mode = mode });
+			}
+
+			if (!quitRequested && glfwWindowShouldClose(m_window))
+			{
+				PushRenderCommand({ .type = RenderCommand::Quit });
+				quitRequested = true;
+			}
+		}
+		renderThread.join();
+	}
+
+	void Shutdown()
+	{
+		m_shaderLibrary.StopWatching();
+		vkDeviceWaitIdle(m_vkDevice);
+
+		// srt[̌vʂÂɊm肵ďo͂.
+		for (uint32_t i = 0; i < uint32_t(m_frames.size()); ++i)
+		{
+			ResolveFrameTimings(m_frames[(m_frameIndex + i) % m_frames.size()]);
+		}
+		WriteProfile();
+
+		m_pipelineManager.Shutdown(m_submitSerial);
+		OutputLog(m_pipelineManager.FormatStats().c_str());
+		m_deletionQueue.Destroy(m_pipelineLayout, m_submitSerial);
+		m_pipelineCache.Shutdown();
+
+		TeardownFramebuffers();
+		for (auto& frame : m_frames)
+		{
+			TeardownPerFrame(frame);
+		}
+		m_frames.clear();
+		m_jobSystem.Shutdown();
+
+		m_deletionQueue.Destroy(m_renderPass, m_submitSerial);
+		m_deletionQueue.Destroy(m_sceneRenderPass, m_submitSerial);
+
+		TeardownImageViews();
+		TeardownOffscreenImages();
+		m_deletionQueue.Destroy(m_swapchainContext.swapchain, m_submitSerial);
+		m_deletionQueue.Destroy(m_timelineSemaphore, m_submitSerial);
+		if (m_useAsyncQueues)
+		{
+			m_computeQueue.Shutdown(m_submitSerial);
+			m_transferQueue.Shutdown(m_submitSerial);
+		}
+
+		if (m_objectCount > 0)
+		{
+			m_objectRenderer.Shutdown(m_submitSerial);
+		}
+
+		// 擪Ŋ҂Ă̂ŁA\񂳂ꂽjׂĎsł.
+		m_uploadRing.Shutdown(m_submitSerial);
+		OutputLog(m_uploadRing.FormatStats().c_str());
+		m_descriptorHeap.Shutdown(m_submitSerial);
+		OutputLog(m_descriptorHeap.FormatStats().c_str());
+		m_gpuAllocator.Shutdown(m_submitSerial);
+		OutputLog(m_gpuAllocator.FormatStats().c_str());
+		m_deletionQueue.FlushAll();
+		{
+			auto str = std::format("Deletion queue: {} destroyed, peak {} pending.\n",
+				m_deletionQueue.GetDestroyedCount(), m_deletionQueue.GetPeakPendingCount());
+			OutputLog(str.c_str());
+		}
+		if (m_deletionQueue.GetLiveCount() > 0)
+		{
+			auto str = std::format("{} Vulkan handles were not destroyed.\n", m_deletionQueue.GetLiveCount());
+			OutputLog(str.c_str());
+			OutputLog(m_deletionQueue.ReportLeaks().c_str());
+		}
+
+		if (m_surface != VK_NULL_HANDLE)
+		{
+			vkDestroySurfaceKHR(m_vkInstance, m_surface, nullptr);
+			m_surface = VK_NULL_HANDLE;
+		}
+
+		if (m_vkDevice != VK_NULL_HANDLE)
+		{
+			vkDestroyDevice(m_vkDevice, nullptr);
+			m_vkDevice = VK_NULL_HANDLE;
+		}
+
+		if (m_debugUtils)
+		{
+			vkDestroyDebugUtilsMessengerEXT(m_vkInstance, m_debugUtils, nullptr);
+			m_debugUtils = VK_NULL_HANDLE;
+		}
+
+		if (m_vkInstance != VK_NULL_HANDLE)
+		{
+			vkDestroyInstance(m_vkInstance, nullptr);
+			m_vkInstance = VK_NULL_HANDLE;
+		}
+
+		if (m_window)
+		{
+			glfwDestroyWindow(m_window);
+			m_window = nullptr;
+		}
+	}
+
+	// Shutdown() ̌ɓǂݏo.
+	const FrameProfiler& GetProfiler() const { return m_profiler; }
+	const std::vector<double>& GetRecreateTimings() const { return m_recreateTimings; }
+	const PresentRecovery& GetRecovery() const { return m_recovery; }
+
+private:
+	void RenderLoop()
+	{
+		auto startTime = std::chrono::steady_clock::now();
+		uint64_t frameCount = 0;
+		// ؂ւ̓C[W擾łɓ frameCount ̂܂ܖ߂Ă̂ŁA1 񂾂؂ւ.
+		uint64_t lastModeSwitchFrame = 0;
+		while (IsRunning(frameCount))
+		{
+			auto frameStart = FrameProfiler::Clock::now();
+			// t[[g̐ƒx[h̑҂́A (`R}h) ǂޑOɍς܂.
+			double pacingWaitMs = m_framePacer.WaitForNextFrame();
+			if (m_lowLatency)
+			{
+				pacingWaitMs += WaitForPreviousFrame();
+			}
+			auto inputTime = FrameProfiler::Clock::now();
+			ProcessRenderCommands();
+			if (m_modeSwitchInterval > 0 && frameCount > 0 && frameCount % m_modeSwitchInterval == 0 && frameCount != lastModeSwitchFrame)
+			{
+				lastModeSwitchFrame = frameCount;
+				CycleDisplayMode();
+			}
+			if (m_quitRequested)
+			{
+				break;
+			}
+			if (m_pendingRecovery != PresentRecovery::Action::None)
+			{
+				// ŏ̓T[tFX̑傫 0 ō蒼Ȃ̂ŁAɖ߂܂ő҂.
+				if (IsSurfaceMinimized())
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(MinimizedPollIntervalMs));
+					continue;
+				}
+				ApplyRecovery();
+			}
+
+			auto& frame = m_frames[m_frameIndex];
+			uint32_t index = 0;
+			auto res = AcquireNextImage(frame, &index);
+			if (res != VK_SUCCESS && res != VK_SUBOPTIMAL_KHR)
+			{
+				// C[W擾łȂ̂ŁÃt[͕`悹ɕA݂.
+				if (!QueueRecovery(m_recovery.OnResult(res, m_mode == ExclusiveFullscreen)))
+				{
+					ReportFatalResult("vkAcquireNextImageKHR", res);
+					break;
+				}
+				continue;
+			}
+			// 擾łC[W͕`悵ăv[gǍō蒼.
+			bool suboptimal = (res == VK_SUBOPTIMAL_KHR);
+			frame.timings.pacingWaitMs = pacingWaitMs;
+
+			UpdatePipelines();
+			m_renderExtent = GetRenderExtent();
+
+			auto recordStart = FrameProfiler::Clock::now();
+			// t[萔̓Abv[hOɒڏ݁AIItZbgŎQƂ.
+			auto frameConstants = m_uploadRing.Push(FrameConstants{
+				.time = float(FrameProfiler::ElapsedMs(m_startTime, recordStart) / 1000.0),
+				.frameIndex = uint32_t(m_submitSerial + 1),
+				.viewportSize = { float(m_renderExtent.width), float(m_renderExtent.height) },
+			});
+			frame.frameConstantsOffset = frameConstants.GetDynamicOffset();
+			VkCommandBufferBeginInfo beginInfo{
+				.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+			};
+			vkBeginCommandBuffer(frame.commandBuffer, &beginInfo);
+
+			// _[pX̑OŃ^CX^v݁AGPUsԂv.
+			if (frame.timestampQueryPool != VK_NULL_HANDLE)
+			{
+				vkCmdResetQueryPool(frame.commandBuffer, frame.timestampQueryPool, 0, 2);
+				vkCmdWriteTimestamp(frame.commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.timestampQueryPool, 0);
+			}
+			
+			// IuWFNg̕`R}h̓_[pX̊O GPU .
+			if (m_objectCount > 0)
+			{
+				RecordObjectCulling(frame.commandBuffer, recordStart);
+			}
+
+			// [J[Xbhꍇ́Ae[J[L^ZJ_R}hobt@s.
+			// I_Oł̓_[OtoAuAepXL^.
+			bool useWorkers = m_jobSystem.GetWorkerCount() > 0;
+			if (m_useDynamicRendering)
+			{
+				m_renderGraph.SetImportedImage(m_swapchainResource, m_swapchainContext.images[index], m_swapchainContext.imageViews[index]);
+				m_recording = { .frame = &frame, .useWorkers = useWorkers };
+				m_renderGraph.Execute(frame.commandBuffer);
+				m_recording = {};
+			}
+			else
+			{
+				BeginRenderPass(frame.commandBuffer, index, useWorkers);
+				if (useWorkers)
+				{
+					RecordSecondaryCommands(frame, m_scaledRendering ? m_sceneTarget.framebuffer : m_swapchainContext.framebuffers[index]);
+				}
+				else
+				{
+					RecordDraws(frame.commandBuffer, 0, m_drawCount, frame.frameConstantsOffset, true);
+				}
+				EndRenderPass(frame.commandBuffer, index);
+			}
+
+			if (frame.timestampQueryPool != VK_NULL_HANDLE)
+			{
+				vkCmdWriteTimestamp(frame.commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.timestampQueryPool, 1);
+			}
+
+			vkEndCommandBuffer(frame.commandBuffer);
+			auto submitStart = FrameProfiler::Clock::now();
+			frame.timings.recordMs = FrameProfiler::ElapsedMs(recordStart, submitStart);
+
+			// wbhXł̓v[e[VGŴŁAZ}tHɂ҂킹sv.
+			// ^CCZ}tHgꍇ́AtFX̑Ƀt[̒ʂԍVOi.
+			uint64_t serial = m_submitSerial + 1;
+			std::array<VkSemaphore, 2> signalSemaphores{};
+			std::array<uint64_t, 2> signalValues{};
+			uint32_t signalCount = 0;
+			if (!m_headless)
+			{
+				signalSemaphores[signalCount++] = m_swapchainContext.renderCompleteSemaphores[index];
+			}
+			if (m_useTimeline)
+			{
+				signalSemaphores[signalCount] = m_timelineSemaphore;
+				signalValues[signalCount++] = serial;
+			}
+			// 񓯊L[̌ʂgꍇ́ÅKvȃXe[Wł҂.
+			std::vector<VkSemaphore> waitSemaphores;
+			std::vector<uint64_t> waitValues;
+			std::vector<VkPipelineStageFlags> waitStages;
+			if (!m_headless)
+			{
+				// k`ł̓Xbv`FC̃C[Wɏނ̂͊g̓].
+				waitSemaphores.push_back(frame.semPresentComplete);
+				waitValues.push_back(0);
+				waitStages.push_back(m_scaledRendering ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+			}
+			for (auto& wait : m_graphicsWaits)
+			{
+				waitSemaphores.push_back(wait.point.semaphore);
+				waitValues.push_back(wait.point.value);
+				waitStages.push_back(wait.stage);
+			}
+			m_graphicsWaits.clear();
+			VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{
+				.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+				.waitSemaphoreValueCount = uint32_t(waitValues.size()),
+				.pWaitSemaphoreValues = waitValues.data(),
+				.signalSemaphoreValueCount = signalCount,
+				.pSignalSemaphoreValues = signalValues.data(),
+			};
+			VkSubmitInfo submitInfo{
+				.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+				.pNext = m_useTimeline ? &timelineSubmitInfo : nullptr,
+				.waitSemaphoreCount = uint32_t(waitSemaphores.size()),
+				.pWaitSemaphores = waitSemaphores.data(),
+				.pWaitDstStageMask = waitStages.data(),
+				.commandBufferCount = 1,
+				.pCommandBuffers = &frame.commandBuffer,
+				.signalSemaphoreCount = signalCount,
+				.pSignalSemaphores = signalSemaphores.data(),
+			};
+			vkQueueSubmit(m_deviceQueue, 1, &submitInfo, m_useTimeline ? VK_NULL_HANDLE : frame.queueSubmitFence);
+			frame.submitSerial = m_submitSerial = serial;
+			auto presentStart = FrameProfiler::Clock::now();
+			frame.timings.submitMs = FrameProfiler::ElapsedMs(submitStart, presentStart);
+			frame.timings.inputLatencyMs = FrameProfiler::ElapsedMs(inputTime, presentStart);
+
+			res = PresentImage(index);
+			if (res == VK_SUCCESS && suboptimal)
+			{
+				res = VK_SUBOPTIMAL_KHR;
+			}
+			bool focusGained = false;
+			res = m_recovery.InjectFault(frameCount, res, &focusGained);
+			auto frameEnd = FrameProfiler::Clock::now();
+			frame.timings.presentMs = FrameProfiler::ElapsedMs(presentStart, frameEnd);
+			frame.timings.frameMs = FrameProfiler::ElapsedMs(frameStart, frameEnd);
+			// GPǓvʂ͂̃Xbg̃tFXɑ҂Ŋm肷.
+			frame.hasPendingTimings = true;
+
+			m_frameIndex = (m_frameIndex + 1) % m_framesInFlight;
+			++frameCount;
+			RecordFramePacing();
+			if (frameCount % ProfileCollectInterval == 0)
+			{
+				m_profiler.Collect();
+			}
+			if (res == VK_SUCCESS)
+			{
+				m_recovery.OnPresented();
+			}
+			else if (!QueueRecovery(m_recovery.OnResult(res, m_mode == ExclusiveFullscreen)))
+			{
+				ReportFatalResult("vkQueuePresentKHR", res);
+				break;
+			}
+			if (focusGained)
+			{
+				QueueRecovery(m_recovery.OnFocusChanged(true));
+			}
+		}
+
+		// St[̊܂ł܂߂Čv.
+		vkQueueWaitIdle(m_deviceQueue);
+		if (frameCount > 0)
+		{
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+			auto str = std::format("{:d} frames in {:.3f} s ({:.1f} fps, {:.3f} ms/frame)\n",
+				frameCount, elapsed.count(), frameCount / elapsed.count(), elapsed.count() * 1000.0 / frameCount);
+			OutputLog(str.c_str());
+		}
+		for (auto& [mode, stats] : m_presentModeStats)
+		{
+			ReportFramePacing(mode, stats);
+		}
+		OutputLog(m_recovery.FormatStats().c_str());
+		OutputLog(m_framePacer.FormatStats().c_str());
+		if (m_scaledRendering && m_resolutionScaler.IsDynamic())
+		{
+			auto str = std::format("Render scale: {:.2f} at exit, {} changes, smoothed GPU time {:.3f} ms (budget {:.2f} ms).\n",
+				m_resolutionScaler.GetScale(), m_resolutionScaler.GetChangeCount(),
+				m_resolutionScaler.GetSmoothedMs(), m_resolutionScaler.GetBudgetMs());
+			OutputLog(str.c_str());
+		}
+	}
+
+	// ũt[̑Oɍs悤\񂷂. AłȂ false Ԃ.
+	// \ς݂̏uꍇ́AXbv`FC̍蒼܂ދc.
+	bool QueueRecovery(PresentRecovery::Action action)
+	{
+		if (action == PresentRecovery::Action::Exit)
+		{
+			return false;
+		}
+		m_pendingRecovery = std::max(m_pendingRecovery, action);
+		return true;
+	}
+
+	void ApplyRecovery()
+	{
+		auto action = std::exchange(m_pendingRecovery, PresentRecovery::Action::None);
+		switch (action)
+		{
+		case PresentRecovery::Action::RecreateSwapchain:
+			RecreateSwapchain();
+			break;
+		case PresentRecovery::Action::FallBackToBorderless:
+			OutputLog("Full-screen exclusive mode lost. Falling back to borderless.\n");
+			EnterBorderlessFullscreen();
+			break;
+		case PresentRecovery::Action::RestoreExclusive:
+			OutputLog("Window focused. Restoring full-screen exclusive mode.\n");
+			// ƂOɃtH[JX߂ꍇ́Ar̂܂܍蒼.
+			if (m_mode == ExclusiveFullscreen)
+			{
+				RecreateSwapchain();
+			}
+			else
+			{
+				EnterExclusiveFullscreen();
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	bool IsSurfaceMinimized() const
+	{
+		if (m_headless)
+		{
+			return false;
+		}
+		VkSurfaceCapabilitiesKHR surfaceCaps{};
+		vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_gpu, m_surface, &surfaceCaps);
+		return surfaceCaps.currentExtent.width == 0 || surfaceCaps.currentExtent.height == 0;
+	}
+
+	void ReportFatalResult(const char* function, VkResult res)
+	{
+		auto str = std::format("{} failed. (result = {:d})", function, (int)res);
+		OutputLog((str + "\n").c_str());
+		m_platform->ShowError(str.c_str());
+	}
+
+	bool InitializeWindow()
+	{
+		// GLFW̏.
+		if (!glfwInit()) {
+			return false;
+		}
+
+		// GLFWVulkangp邱Ƃw.
+		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+		glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+
+		// EBhE𐶐.
+		m_window = glfwCreateWindow(1280, 720, "Sample", nullptr, nullptr);
+		if (!m_window)
+		{
+			return false;
+		}
+		glfwSetWindowUserPointer(m_window, this);
+		glfwSetKeyCallback(m_window, KeyProcessCallback);
+		glfwSetWindowSizeCallback(m_window, WindowSizeCallback);
+		glfwSetWindowFocusCallback(m_window, WindowFocusCallback);
+
+		m_platform->AttachWindow(m_window);
+		return true;
+	}
+
+	bool IsRunning(uint64_t frameCount) const
+	{
+		if (m_frameLimit != 0 && frameCount >= m_frameLimit)
+		{
+			return false;
+		}
+		return !m_quitRequested;
+	}
+
+	bool InitializeVulkanInstance()
+	{
+		if (volkInitialize() != VK_SUCCESS)
+		{
+			OutputLog("volkInitialize failed.\n");
+			return false;
+		}
+		uint32_t instanceExtensionCount;
+		vkEnumerateInstanceExtensionProperties(nullptr, &instanceExtensionCount, nullptr);
+		std::vector<VkExtensionProperties> instanceExtensions(instanceExtensionCount);
+		vkEnumerateInstanceExtensionProperties(nullptr, &instanceExtensionCount, instanceExtensions.data());
+
+		// [_[ΉĂΐVo[WvA^CCZ}tH̃RA@\g悤ɂ.
+		m_instanceApiVersion = std::min(volkGetInstanceVersion(), VK_API_VERSION_1_3);
+
+		std::vector<const char*> activeInstanceExtensions;
+
+		// wbhXł̓T[tFX֘Åg@\͕sv.
+		if (!m_headless)
+		{
+			uint32_t glfwRequiredCount;
+			auto glfwRequiredExtensionNames = glfwGetRequiredInstanceExtensions(&glfwRequiredCount);
+			std::for_each_n(glfwRequiredExtensionNames, glfwRequiredCount, [&](auto v) { activeInstanceExtensions.push_back(v); });
+
+			// rtXN[ȂǁAOS ƂɕKvȊg@\.
+			auto platformExtensions = m_platform->GetInstanceExtensions();
+			activeInstanceExtensions.insert(activeInstanceExtensions.end(), platformExtensions.begin(), platformExtensions.end());
+		}
+#ifdef _DEBUG
+		activeInstanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+#endif
+		
+		std::vector<const char*> activeInstanceLayers = {
+#ifdef _DEBUG
+			"VK_LAYER_KHRONOS_validation"
+#endif
+		};
+
+		VkApplicationInfo appInfo{
+			.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+			.pApplicationName = "Fullscreen Sample",
+			.pEngineName = "Sample",
+			.apiVersion = m_instanceApiVersion,
+		};
+
+		VkInstanceCreateInfo instanceCreateInfo = {
+			.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+			.pApplicationInfo = &appInfo,
+			.enabledLayerCount = uint32_t(activeInstanceLayers.size()),
+			.ppEnabledLayerNames = (activeInstanceLayers.size() > 0) ? activeInstanceLayers.data() : nullptr,
+			.enabledExtensionCount = uint32_t(activeInstanceExtensions.size()),
+			.ppEnabledExtensionNames = (activeInstanceExtensions.size()>0) ? activeInstanceExtensions.data() : nullptr,
+		};
+
+#ifdef _DEBUG
+		VkDebugUtilsMessengerCreateInfoEXT debugUtilsCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT,
+			.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT,
+			.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT,
+			.pfnUserCallback = VulkanDebugCallback,
+		};
+		instanceCreateInfo.pNext = &debugUtilsCreateInfo;
+#endif
+		auto res = vkCreateInstance(&instanceCreateInfo, nullptr, &m_vkInstance);
+		if (res != VK_SUCCESS)
+		{
+			OutputLog("Failed vkCreateInstance().\n");
+			return false;
+		}
+		volkLoadInstance(m_vkInstance);
+#ifdef _DEBUG
+		res = vkCreateDebugUtilsMessengerEXT(m_vkInstance, &debugUtilsCreateInfo, nullptr, &m_debugUtils);
+		if (res != VK_SUCCESS)
+		{
+			OutputLog("Failed vkCreateDebugUtilsMessengerEXT().\n");
+			return false;
+		}
+#endif
+
+		return true;
+	}
+
+	bool InitializeVulkanDevice()
+	{
+		std::vector<const char*> activeDeviceExtensions;
+		if (!m_headless)
+		{
+			activeDeviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+			auto platformExtensions = m_platform->GetDeviceExtensions();
+			activeDeviceExtensions.insert(activeDeviceExtensions.end(), platformExtensions.begin(), platformExtensions.end());
+		}
+
+		// ̓_čł\̍foCXI. --gpu ŖO UUID w肷΂D悷.
+		DeviceSelector selector;
+		auto selected = selector.Select(m_vkInstance, DeviceSelector::Requirements{
+			.surface = m_surface,
+			.requiredExtensions = activeDeviceExtensions,
+			.optionalExtensions = { VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME },
+			.override = m_gpuOverride,
+			.instanceApiVersion = m_instanceApiVersion,
+		});
+		OutputLog(selector.Report(selected ? &*selected : nullptr).c_str());
+		if (!selected)
+		{
+			return false;
+		}
+		m_gpu = selected->gpu;
+		m_graphicsQueueIndex = selected->graphicsQueueFamily;
+
+		// GPU 쓮̕`͕`搔 GPU Ō߂Ԑڕ`ƁAfirstInstance ɂIuWFNg̎w肪O.
+		VkPhysicalDeviceFeatures supportedFeatures;
+		vkGetPhysicalDeviceFeatures(m_gpu, &supportedFeatures);
+		VkPhysicalDeviceFeatures enabledFeatures{};
+		if (m_objectCount > 0)
+		{
+			if (supportedFeatures.multiDrawIndirect && supportedFeatures.drawIndirectFirstInstance &&
+				selected->HasExtension(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME))
+			{
+				enabledFeatures.multiDrawIndirect = VK_TRUE;
+				enabledFeatures.drawIndirectFirstInstance = VK_TRUE;
+				activeDeviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+			}
+			else
+			{
+				OutputLog("Objects: indirect count drawing is not supported, disabled.\n");
+				m_objectCount = 0;
+			}
+		}
+
+		if (m_headless)
+		{
+			// ItXN[C[W̓J[A^b`gƂĎg`I.
+			for (auto candidate : { VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_R8G8B8A8_UNORM })
+			{
+				VkFormatProperties formatProps;
+				vkGetPhysicalDeviceFormatProperties(m_gpu, candidate, &formatProps);
+				if (formatProps.optimalTilingFeatures & VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT)
+				{
+					m_swapchainContext.format = candidate;
+					break;
+				}
+			}
+		}
+		else
+		{
+			uint32_t formatCount;
+			vkGetPhysicalDeviceSurfaceFormatsKHR(m_gpu, m_surface, &formatCount, nullptr);
+			std::vector<VkSurfaceFormatKHR> formats(formatCount);
+			vkGetPhysicalDeviceSurfaceFormatsKHR(m_gpu, m_surface, &formatCount, formats.data());
+
+			for (auto& f : formats)
+			{
+				if (f.format == VK_FORMAT_B8G8R8A8_UNORM)
+				{
+					m_swapchainContext.format = f.format;
+					break;
+				}
+			}
+			if (m_swapchainContext.format == VK_FORMAT_UNDEFINED)
+			{
+				for (auto& f : formats)
+				{
+					if (f.format == VK_FORMAT_R8G8B8A8_UNORM)
+					{
+						m_swapchainContext.format = f.format;
+						break;
+					}
+				}
+			}
+
+			uint32_t presentModeCount;
+			vkGetPhysicalDeviceSurfacePresentModesKHR(m_gpu, m_surface, &presentModeCount, nullptr);
+			std::vector<VkPresentModeKHR> presentModes(presentModeCount);
+			vkGetPhysicalDeviceSurfacePresentModesKHR(m_gpu, m_surface, &presentModeCount, presentModes.data());
+
+			// ؂ւ͊m̃[ĥ(Lv[e[Vn͏).
+			m_swapchainContext.presentModes.clear();
+			for (auto& [mode, name] : PresentModeNames)
+			{
+				if (std::ranges::find(presentModes, mode) != presentModes.end())
+				{
+					m_swapchainContext.presentModes.push_back(mode);
+				}
+			}
+			m_swapchainContext.presentMode = SelectPresentMode();
+			auto str = std::format("Present mode: {}\n", GetPresentModeName(m_swapchainContext.presentMode));
+			OutputLog(str.c_str());
+		}
+
+		// ^CCZ}tH Vulkan 1.2 ̃RA@\ VK_KHR_timeline_semaphore Ŏg.
+		// ǂ΃tFXɂҋ@ɖ߂.
+		const auto& deviceProperties = selected->properties;
+		bool timelineCore = std::min(deviceProperties.apiVersion, m_instanceApiVersion) >= VK_API_VERSION_1_2;
+		m_useTimeline = m_useTimeline && selected->supportsTimelineSemaphore;
+		VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES,
+			.timelineSemaphore = VK_TRUE,
+		};
+		if (m_useTimeline && !timelineCore)
+		{
+			activeDeviceExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+		}
+
+		// I_O Vulkan 1.3 ̃RA@\ VK_KHR_dynamic_rendering Ŏg.
+		// ǂ΃_[pXƃt[obt@ŕ`悷.
+		bool dynamicRenderingCore = std::min(deviceProperties.apiVersion, m_instanceApiVersion) >= VK_API_VERSION_1_3;
+		m_useDynamicRendering = m_useDynamicRendering && selected->supportsDynamicRendering;
+		VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES,
+			.dynamicRendering = VK_TRUE,
+		};
+		if (m_useDynamicRendering && !dynamicRenderingCore)
+		{
+			activeDeviceExtensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+		}
+
+		// oChX̃fXNv^ Vulkan 1.2 ̃RA@\ VK_EXT_descriptor_indexing Ŏg.
+		// ǂ΃oChX̃ZbgȂ.
+		bool descriptorIndexingCore = std::min(deviceProperties.apiVersion, m_instanceApiVersion) >= VK_API_VERSION_1_2;
+		m_useBindless = m_useBindless && selected->supportsDescriptorIndexing;
+		VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES,
+			.shaderSampledImageArrayNonUniformIndexing = VK_TRUE,
+			.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE,
+			.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE,
+			.descriptorBindingUpdateUnusedWhilePending = VK_TRUE,
+			.descriptorBindingPartiallyBound = VK_TRUE,
+			.runtimeDescriptorArray = VK_TRUE,
+		};
+		if (m_useBindless && !descriptorIndexingCore)
+		{
+			activeDeviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+		}
+
+		// _[Ot̃oA Vulkan 1.3 ̃RA@\ VK_KHR_synchronization2 ŋL^.
+		// ǂ vkCmdPipelineBarrier ɕϊ.
+		bool synchronization2Core = std::min(deviceProperties.apiVersion, m_instanceApiVersion) >= VK_API_VERSION_1_3;
+		bool useSynchronization2 = selected->supportsSynchronization2;
+		VkPhysicalDeviceSynchronization2Features synchronization2Features{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES,
+			.synchronization2 = VK_TRUE,
+		};
+		if (useSynchronization2 && !synchronization2Core)
+		{
+			activeDeviceExtensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+		}
+
+		// x[hł́AVK_KHR_present_id  VK_KHR_present_wait ΑÕt[̕\҂.
+		m_usePresentWait = m_lowLatency && !m_headless && selected->supportsPresentWait;
+		VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+			.presentId = VK_TRUE,
+		};
+		VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR,
+			.pNext = &presentIdFeatures,
+			.presentWait = VK_TRUE,
+		};
+		if (m_usePresentWait)
+		{
+			activeDeviceExtensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+			activeDeviceExtensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+		}
+
+		// 񓯊Rs[gƓ]̃L[. ̊^CCZ}tHő҂킹̂ŁAꂪO.
+		// t@~[ɋ󂫂̃L[΁AɊ蓖ĂL[L.
+		m_useAsyncQueues = m_useAsyncQueues && m_useTimeline;
+		std::map<uint32_t, uint32_t> queueCounts;
+		auto allocateQueue = [&](uint32_t family) {
+			auto& count = queueCounts[family];
+			auto index = std::min(count, selected->queueFamilies[family].queueCount - 1);
+			count = std::min(count + 1, selected->queueFamilies[family].queueCount);
+			return index;
+		};
+		allocateQueue(m_graphicsQueueIndex);
+		if (m_useAsyncQueues)
+		{
+			m_computeQueueFamily = selected->computeQueueFamily;
+			m_transferQueueFamily = selected->transferQueueFamily;
+			m_computeQueueIndex = allocateQueue(m_computeQueueFamily);
+			m_transferQueueIndex = allocateQueue(m_transferQueueFamily);
+		}
+
+		std::vector<float> queuePriorities(4, 1.0f);
+		std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
+		for (auto& [family, count] : queueCounts)
+		{
+			queueCreateInfos.push_back(VkDeviceQueueCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+				.queueFamilyIndex = family,
+				.queueCount = count,
+				.pQueuePriorities = queuePriorities.data(),
+			});
+		}
+		VkDeviceCreateInfo deviceCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+			.queueCreateInfoCount = uint32_t(queueCreateInfos.size()),
+			.pQueueCreateInfos = queueCreateInfos.data(),
+			.enabledExtensionCount = uint32_t(activeDeviceExtensions.size()),
+			.ppEnabledExtensionNames = (activeDeviceExtensions.size() > 0) ? activeDeviceExtensions.data() : nullptr,
+			.pEnabledFeatures = &enabledFeatures,
+		};
+		if (m_useDynamicRendering)
+		{
+			dynamicRenderingFeatures.pNext = const_cast<void*>(deviceCreateInfo.pNext);
+			deviceCreateInfo.pNext = &dynamicRenderingFeatures;
+		}
+		if (m_useTimeline)
+		{
+			timelineFeatures.pNext = const_cast<void*>(deviceCreateInfo.pNext);
+			deviceCreateInfo.pNext = &timelineFeatures;
+		}
+		if (m_useBindless)
+		{
+			descriptorIndexingFeatures.pNext = const_cast<void*>(deviceCreateInfo.pNext);
+			deviceCreateInfo.pNext = &descriptorIndexingFeatures;
+		}
+		if (useSynchronization2)
+		{
+			synchronization2Features.pNext = const_cast<void*>(deviceCreateInfo.pNext);
+			deviceCreateInfo.pNext = &synchronization2Features;
+		}
+		if (m_usePresentWait)
+		{
+			presentIdFeatures.pNext = const_cast<void*>(deviceCreateInfo.pNext);
+			deviceCreateInfo.pNext = &presentWaitFeatures;
+		}
+		auto res = vkCreateDevice(m_gpu, &deviceCreateInfo, nullptr, &m_vkDevice);
+		if (res != VK_SUCCESS)
+		{
+			OutputLog("vkCreateDevice failed.\n");
+			return false;
+		}
+		volkLoadDevice(m_vkDevice);
+		vkGetDeviceQueue(m_vkDevice, m_graphicsQueueIndex, 0, &m_deviceQueue);
+		if (m_useTimeline)
+		{
+			m_waitSemaphores = timelineCore ? vkWaitSemaphores : vkWaitSemaphoresKHR;
+			m_getSemaphoreCounterValue = timelineCore ? vkGetSemaphoreCounterValue : vkGetSemaphoreCounterValueKHR;
+		}
+		if (m_useDynamicRendering)
+		{
+			m_cmdBeginRendering = dynamicRenderingCore ? vkCmdBeginRendering : vkCmdBeginRenderingKHR;
+			m_cmdEndRendering = dynamicRenderingCore ? vkCmdEndRendering : vkCmdEndRenderingKHR;
+		}
+		if (useSynchronization2)
+		{
+			m_cmdPipelineBarrier2 = synchronization2Core ? vkCmdPipelineBarrier2 : vkCmdPipelineBarrier2KHR;
+		}
+		OutputLog(m_useDynamicRendering ? "Render path: dynamic rendering\n" : "Render path: render pass\n");
+		if (m_lowLatency)
+		{
+			OutputLog(m_usePresentWait ? "Low latency: wait for the previous present\n" : "Low latency: wait for the previous frame on the GPU\n");
+		}
+
+		// ^CX^vgȂL[ł GPU Ԃ̌vsȂ.
+		m_timestampPeriod = deviceProperties.limits.timestampPeriod;
+		m_timestampValidBits = selected->timestampValidBits;
+		return true;
+	}
+
+	// 쐬Ɏsꍇ false Ԃ. ÂXbv`FC̃C[Wr[ƃt[obt@͂̂܂܎c.
+	bool InitializeSwapchain()
+	{
+		if (m_headless)
+		{
+			return InitializeOffscreenImages();
+		}
+
+		VkSurfaceCapabilitiesKHR surfaceCaps{};
+		vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_gpu, m_surface, &surfaceCaps);
+		
+		VkExtent2D swapchainSize;
+
+		if (surfaceCaps.currentExtent.width == 0xFFFFFFFFu)
+		{
+			swapchainSize = { 1280, 720 };
+		}
+		else
+		{
+			swapchainSize = surfaceCaps.currentExtent;
+		}
+
+		if (isFullscreen())
+		{
+			swapchainSize = surfaceCaps.maxImageExtent;
+		}
+
+		VkPresentModeKHR presentMode = m_swapchainContext.presentMode;
+		uint32_t desiredSwapchainImages = m_swapchainImageCount > 0 ? m_swapchainImageCount : surfaceCaps.minImageCount + 1;
+		desiredSwapchainImages = std::max(surfaceCaps.minImageCount, desiredSwapchainImages);
+		// maxImageCount  0 Ȃ͖.
+		if (surfaceCaps.maxImageCount > 0)
+		{
+			desiredSwapchainImages = std::min(surfaceCaps.maxImageCount, desiredSwapchainImages);
+		}
+
+		VkSwapchainKHR oldSwapchain = m_swapchainContext.swapchain;
+		VkSwapchainCreateInfoKHR swapchainCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
+			.surface = m_surface,
+			.minImageCount = desiredSwapchainImages,
+			.imageFormat = m_swapchainContext.format,
+			.imageColorSpace = VK_COLORSPACE_SRGB_NONLINEAR_KHR,
+			.imageExtent = swapchainSize,
+			.imageArrayLayers = 1,
+			.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | (m_scaledRendering ? VkImageUsageFlags(VK_IMAGE_USAGE_TRANSFER_DST_BIT) : 0u),
+			.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE,
+			.preTransform = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR,
+			.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
+			.presentMode = presentMode,
+			.clipped = VK_TRUE,
+			.oldSwapchain = oldSwapchain,
+		};
+
+		swapchainCreateInfo.pNext = m_platform->GetSwapchainCreateInfoNext();
+
+		VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+		auto res = vkCreateSwapchainKHR(m_vkDevice, &swapchainCreateInfo, nullptr, &swapchain);
+		if (res != VK_SUCCESS)
+		{
+			auto str = std::format("vkCreateSwapchainKHR failed. (result = {:d})\n", (int)res);
+			OutputLog(str.c_str());
+			return false;
+		}
+		m_swapchainContext.swapchain = m_deletionQueue.Track(swapchain);
+		// ÕXbv`FCւ̃v[ǵAVXbv`FCł͑҂ĂȂ.
+		m_lastPresentId = 0;
+
+		if (oldSwapchain != VK_NULL_HANDLE)
+		{
+			// ÂXbv`FC̃C[W͂܂GPUŎgp̉\.
+			// ҋ@ɔj\񂵁Aς݂̃t[Ăj.
+			TeardownFramebuffers();
+			TeardownImageViews();
+			m_deletionQueue.Destroy(oldSwapchain, m_submitSerial);
+		}
+		m_swapchainContext.dimensions = swapchainSize;
+		uint32_t imageCount;
+		vkGetSwapchainImagesKHR(m_vkDevice, m_swapchainContext.swapchain, &imageCount, nullptr);
+		std::vector<VkImage> swapchainImages(imageCount);
+		vkGetSwapchainImagesKHR(m_vkDevice, m_swapchainContext.swapchain, &imageCount, swapchainImages.data());
+
+		InitializeImageViews(swapchainImages);
+		return true;
+	}
+
+	// wbhX쎞ɃXbv`FC̑ƂȂItXN[C[W̃O쐬.
+	// mۂłȂ΍쐬r̃C[Wj false Ԃ.
+	bool InitializeOffscreenImages()
+	{
+		// 蒼̏ꍇAÂC[W͓ς݂̃t[Ăj.
+		if (!m_swapchainContext.offscreenImages.empty())
+		{
+			TeardownFramebuffers();
+			TeardownImageViews();
+			TeardownOffscreenImages();
+		}
+		m_swapchainContext.dimensions = m_headlessExtent;
+
+		uint32_t imageCount = m_swapchainImageCount > 0 ? m_swapchainImageCount : HeadlessImageCount;
+		for (uint32_t i = 0; i < imageCount; ++i)
+		{
+			VkImageCreateInfo imageCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+				.imageType = VK_IMAGE_TYPE_2D,
+				.format = m_swapchainContext.format,
+				.extent = { m_headlessExtent.width, m_headlessExtent.height, 1 },
+				.mipLevels = 1,
+				.arrayLayers = 1,
+				.samples = VK_SAMPLE_COUNT_1_BIT,
+				.tiling = VK_IMAGE_TILING_OPTIMAL,
+				.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+				.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+				.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+			};
+			VkImage image;
+			vkCreateImage(m_vkDevice, &imageCreateInfo, nullptr, &image);
+			m_deletionQueue.Track(image);
+
+			VkMemoryRequirements memoryRequirements;
+			vkGetImageMemoryRequirements(m_vkDevice, image, &memoryRequirements);
+			auto allocation = m_gpuAllocator.Allocate(memoryRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, false);
+			if (!allocation.IsValid())
+			{
+				OutputLog("Failed to allocate memory for offscreen images.\n");
+				m_deletionQueue.Destroy(image, m_submitSerial);
+				TeardownOffscreenImages();
+				return false;
+			}
+			vkBindImageMemory(m_vkDevice, image, allocation.memory, allocation.offset);
+
+			m_swapchainContext.offscreenImages.push_back(image);
+			m_swapchainContext.offscreenAllocations.push_back(allocation);
+		}
+		m_swapchainContext.nextImageIndex = 0;
+		InitializeImageViews(m_swapchainContext.offscreenImages);
+		return true;
+	}
+
+	void TeardownOffscreenImages()
+	{
+		for (auto& image : m_swapchainContext.offscreenImages)
+		{
+			m_deletionQueue.Destroy(image, m_submitSerial);
+		}
+		for (auto& allocation : m_swapchainContext.offscreenAllocations)
+		{
+			m_gpuAllocator.Free(allocation, m_submitSerial);
+		}
+		m_swapchainContext.offscreenImages.clear();
+		m_swapchainContext.offscreenAllocations.clear();
+	}
+
+	void InitializeImageViews(const std::vector<VkImage>& images)
+	{
+		// VC[W͂܂ǂ̃t[gpĂȂ.
+		m_swapchainContext.imageFences.assign(images.size(), VK_NULL_HANDLE);
+		m_swapchainContext.imageSerials.assign(images.size(), 0);
+		m_swapchainContext.images = images;
+		for (size_t i = 0; i < images.size(); ++i)
+		{
+			VkImageViewCreateInfo viewCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+				.image = images[i],
+				.viewType = VK_IMAGE_VIEW_TYPE_2D,
+				.format = m_swapchainContext.format,
+				.components = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A },
+				.subresourceRange = {
+					.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+					.baseMipLevel = 0,
+					.levelCount = 1,
+					.baseArrayLayer = 0,
+					.layerCount = 1
+				}
+			};
+			VkImageView view;
+			vkCreateImageView(m_vkDevice, &viewCreateInfo, nullptr, &view);
+			m_deletionQueue.Track(view);
+			m_swapchainContext.imageViews.push_back(view);
+		}
+
+		// `抮̃Z}tH̓v[g҂̂ŁAt[̃Xbgł͂ȂC[WƂɎ.
+		// XbgƂɂƁAv[e[VGW܂҂ĂZ}tH̃t[VOiĂ܂.
+		if (!m_headless)
+		{
+			VkSemaphoreCreateInfo semaphoreCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO
+			};
+			for (size_t i = 0; i < images.size(); ++i)
+			{
+				VkSemaphore semaphore;
+				vkCreateSemaphore(m_vkDevice, &semaphoreCreateInfo, nullptr, &semaphore);
+				m_deletionQueue.Track(semaphore);
+				m_swapchainContext.renderCompleteSemaphores.push_back(semaphore);
+			}
+		}
+	}
+
+	// ς݂̃t[Ăj.
+	void TeardownImageViews()
+	{
+		for (auto& view : m_swapchainContext.imageViews)
+		{
+			m_deletionQueue.Destroy(view, m_submitSerial);
+		}
+		m_swapchainContext.imageViews.clear();
+		for (auto& semaphore : m_swapchainContext.renderCompleteSemaphores)
+		{
+			m_deletionQueue.Destroy(semaphore, m_submitSerial);
+		}
+		m_swapchainContext.renderCompleteSemaphores.clear();
+	}
+
+
+	void InitializeRenderPass()
+	{
+		if (m_useDynamicRendering)
+		{
+			return;
+		}
+		VkAttachmentDescription attachment = { 0 };
+		attachment.format = m_swapchainContext.format;
+		attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+		attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+		attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+		attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		// wbhXł͓ǂݏo(])ɎgԂŏI.
+		attachment.finalLayout = m_headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+		VkAttachmentReference colorRef = { 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+
+		VkSubpassDescription subpass = { 0 };
+		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.colorAttachmentCount = 1;
+		subpass.pColorAttachments = &colorRef;
+
+		VkSubpassDependency dependency = { 
+			.srcSubpass = VK_SUBPASS_EXTERNAL,
+			.dstSubpass = 0,
+			.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+			.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+			.srcAccessMask = 0,
+			.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+		};
+
+		VkRenderPassCreateInfo rp_info = { 
+			.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+			.attachmentCount = 1,
+			.pAttachments = &attachment,
+			.subpassCount = 1,
+			.pSubpasses = &subpass,
+			.dependencyCount = 1,
+			.pDependencies = &dependency
+		};
+
+		vkCreateRenderPass(m_vkDevice, &rp_info, nullptr, &m_renderPass);
+		m_deletionQueue.Track(m_renderPass);
+
+		if (!m_scaledRendering)
+		{
+			return;
+		}
+		// k`̕`p. A^b`ǧ`Ȃ̂ m_renderPass ƌ݊ŁApCvC͂̂܂܎g.
+		// Õt[̊g (]ƂĂ̓ǂݏo) IĂ珑݁AIg̓]ɓn.
+		attachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		std::array<VkSubpassDependency, 2> sceneDependencies{{
+			{
+				.srcSubpass = VK_SUBPASS_EXTERNAL,
+				.dstSubpass = 0,
+				.srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+				.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+				.srcAccessMask = 0,
+				.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+			},
+			{
+				.srcSubpass = 0,
+				.dstSubpass = VK_SUBPASS_EXTERNAL,
+				.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+				.dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+				.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+				.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+			},
+		}};
+		rp_info.dependencyCount = uint32_t(sceneDependencies.size());
+		rp_info.pDependencies = sceneDependencies.data();
+		vkCreateRenderPass(m_vkDevice, &rp_info, nullptr, &m_sceneRenderPass);
+		m_deletionQueue.Track(m_sceneRenderPass);
+	}
+
+	void InitializePipeline()
+	{
+		// set = 0 ̓t[萔Aset = 1 ̓oChX̔z.
+		// ̃VF[_[͕`悲Ƃ̒lǂ܂Ȃ̂ŁAvbV萔͈͍̔͂Ȃ.
+		std::vector<VkDescriptorSetLayout> setLayouts;
+		if (auto setLayout = m_uploadRing.GetDescriptorSetLayout(); setLayout != VK_NULL_HANDLE)
+		{
+			setLayouts.push_back(setLayout);
+			if (m_descriptorHeap.IsBindless())
+			{
+				setLayouts.push_back(m_descriptorHeap.GetBindlessSetLayout());
+			}
+		}
+		m_bindlessSetBound = setLayouts.size() > BindlessSetIndex;
+		VkPipelineLayoutCreateInfo layoutInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+			.setLayoutCount = uint32_t(setLayouts.size()),
+			.pSetLayouts = setLayouts.data(),
+		};
+		vkCreatePipelineLayout(m_vkDevice, &layoutInfo, nullptr, &m_pipelineLayout);
+		m_deletionQueue.Track(m_pipelineLayout);
+
+		// 쐬̓[J[ōsA҂ɋNi߂. ܂ł͎Op``悵Ȃ.
+		m_pipelineState = GraphicsPipelineState{
+			.vertexShader = "shader.vert.spv",
+			.fragmentShader = "shader.frag.spv",
+			.layout = m_pipelineLayout,
+			.renderPass = m_renderPass,
+			.colorFormat = m_swapchainContext.format,
+		};
+		m_pipelineRequestTime = FrameProfiler::Clock::now();
+		m_pipelineManager.Prefetch(m_pipelineState);
+	}
+
+	// t[̋L^n߂OɁA쐬IpCvC𔽉f.
+	// uÂpCvĆAgp̃t[Ăj.
+	void UpdatePipelines()
+	{
+		m_pipelineManager.Update(m_submitSerial);
+		bool wasReady = m_pipeline != VK_NULL_HANDLE;
+		m_pipeline = m_pipelineManager.Get(m_pipelineState);
+		if (m_objectCount > 0)
+		{
+			m_objectPipeline = m_pipelineManager.Get(m_objectPipelineState);
+		}
+
+		// LbV̗Lɂ쐬Ԃ̈ႢmFł悤ɂĂ.
+		if (!wasReady && m_pipeline != VK_NULL_HANDLE)
+		{
+			auto str = std::format("Pipeline creation: {:.3f} ms ({} cache).\n",
+				FrameProfiler::ElapsedMs(m_pipelineRequestTime, FrameProfiler::Clock::now()), m_pipelineCache.IsWarm() ? "warm" : "cold");
+			OutputLog(str.c_str());
+		}
+	}
+
+	// IuWFNg̃obt@ƃpCvCAf[^].
+	// 񓯊̓]L[΂ŃRs[Aŏ̃t[ŃOtBbNXL[L󂯎.
+	// 񓯊̃Rs[gL[΁At[̃JOōs.
+	void InitializeObjects()
+	{
+		if (m_objectCount == 0)
+		{
+			return;
+		}
+		std::vector<uint32_t> queueFamilies{ m_graphicsQueueIndex };
+		if (m_useAsyncQueues)
+		{
+			queueFamilies.push_back(m_computeQueueFamily);
+			queueFamilies.push_back(m_transferQueueFamily);
+		}
+		if (!m_objectRenderer.Initialize(m_vkDevice, m_gpuAllocator, m_deletionQueue, m_pipelineCache.GetHandle(),
+			m_objectCount, m_framesInFlight, queueFamilies, vkCmdDrawIndexedIndirectCountKHR))
+		{
+			OutputLog("Objects: failed to allocate buffers, disabled.\n");
+			m_objectRenderer.Shutdown(m_submitSerial);
+			m_objectCount = 0;
+			return;
+		}
+		m_objectPipelineState = GraphicsPipelineState{
+			.vertexShader = "instance.vert.spv",
+			.fragmentShader = "shader.frag.spv",
+			.layout = m_objectRenderer.GetPipelineLayout(),
+			.renderPass = m_renderPass,
+			.colorFormat = m_swapchainContext.format,
+		};
+		m_pipelineManager.Prefetch(m_objectPipelineState);
+
+		m_objectsUploadOnGraphics = !m_useAsyncQueues;
+		m_objectTransfer = QueueOwnershipTransfer{
+			.srcFamily = m_objectsUploadOnGraphics ? m_graphicsQueueIndex : m_transferQueueFamily,
+			.dstFamily = m_graphicsQueueIndex,
+		};
+		m_cullTransfer = QueueOwnershipTransfer{
+			.srcFamily = m_useAsyncQueues ? m_computeQueueFamily : m_graphicsQueueIndex,
+			.dstFamily = m_graphicsQueueIndex,
+		};
+		if (!m_objectsUploadOnGraphics)
+		{
+			auto commandBuffer = m_transferQueue.Begin();
+			m_objectRenderer.RecordUpload(commandBuffer, m_objectTransfer);
+			m_objectsUploadPoint = m_transferQueue.Submit();
+			WaitOnGraphics(m_objectsUploadPoint, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT);
+		}
+		m_objectsPendingAcquire = true;
+
+		auto str = std::format("Objects: {} (upload on {} queue, cull on {} queue)\n", m_objectCount,
+			m_objectsUploadOnGraphics ? "graphics" : "transfer", m_useAsyncQueues ? "compute" : "graphics");
+		OutputLog(str.c_str());
+	}
+
+	// I_Oł̓t[obt@炸A_[OtgݗĂ.
+	void InitializeFramebuffers()
+	{
+		if (m_useDynamicRendering)
+		{
+			BuildRenderGraph();
+			return;
+		}
+		InitializeSceneTarget();
+		for (auto& view : m_swapchainContext.imageViews)
+		{
+			VkFramebufferCreateInfo framebufferCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+				.renderPass = m_renderPass,
+				.attachmentCount = 1,
+				.pAttachments = &view,
+				.width = m_swapchainContext.dimensions.width,
+				.height = m_swapchainContext.dimensions.height,
+				.layers = 1,
+			};
+			VkFramebuffer fb;
+			vkCreateFramebuffer(m_vkDevice, &framebufferCreateInfo, nullptr, &fb);
+			m_deletionQueue.Track(fb);
+			m_swapchainContext.framebuffers.push_back(fb);
+		}
+	}
+
+	// _[pXŏk`悷Ƃ̕`. Xbv`FCƓ傫ōA{ɉč̈ꕔĝŁA
+	// {ςĂ蒼ɍς. I_Oł̓_[OẗꎞC[Wg.
+	void InitializeSceneTarget()
+	{
+		if (!m_scaledRendering)
+		{
+			return;
+		}
+		auto extent = m_swapchainContext.dimensions;
+		VkImageCreateInfo imageCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+			.imageType = VK_IMAGE_TYPE_2D,
+			.format = m_swapchainContext.format,
+			.extent = { extent.width, extent.height, 1 },
+			.mipLevels = 1,
+			.arrayLayers = 1,
+			.samples = VK_SAMPLE_COUNT_1_BIT,
+			.tiling = VK_IMAGE_TILING_OPTIMAL,
+			.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+			.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+			.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+		};
+		vkCreateImage(m_vkDevice, &imageCreateInfo, nullptr, &m_sceneTarget.image);
+		m_deletionQueue.Track(m_sceneTarget.image);
+
+		VkMemoryRequirements memoryRequirements;
+		vkGetImageMemoryRequirements(m_vkDevice, m_sceneTarget.image, &memoryRequirements);
+		m_sceneTarget.allocation = m_gpuAllocator.Allocate(memoryRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, false);
+		if (!m_sceneTarget.allocation.IsValid())
+		{
+			// _[OẗꎞC[WƓAΏkɃXbv`FC֒ڕ`悷.
+			OutputLog("Scene target: failed to allocate memory, render scale disabled.\n");
+			m_deletionQueue.Destroy(m_sceneTarget.image, m_submitSerial);
+			m_sceneTarget = {};
+			m_scaledRendering = false;
+			return;
+		}
+		vkBindImageMemory(m_vkDevice, m_sceneTarget.image, m_sceneTarget.allocation.memory, m_sceneTarget.allocation.offset);
+
+		VkImageViewCreateInfo viewCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+			.image = m_sceneTarget.image,
+			.viewType = VK_IMAGE_VIEW_TYPE_2D,
+			.format = m_swapchainContext.format,
+			.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+		};
+		vkCreateImageView(m_vkDevice, &viewCreateInfo, nullptr, &m_sceneTarget.view);
+		m_deletionQueue.Track(m_sceneTarget.view);
+
+		if (!m_useDynamicRendering)
+		{
+			VkFramebufferCreateInfo framebufferCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+				.renderPass = m_sceneRenderPass,
+				.attachmentCount = 1,
+				.pAttachments = &m_sceneTarget.view,
+				.width = extent.width,
+				.height = extent.height,
+				.layers = 1,
+			};
+			vkCreateFramebuffer(m_vkDevice, &framebufferCreateInfo, nullptr, &m_sceneTarget.framebuffer);
+			m_deletionQueue.Track(m_sceneTarget.framebuffer);
+		}
+	}
+
+	// g̓]Ɠ]Ɏg邩. kC[W̓Xbv`FCƓ`ō.
+	bool SupportsScaledRendering() const
+	{
+		VkFormatProperties formatProps;
+		vkGetPhysicalDeviceFormatProperties(m_gpu, m_swapchainContext.format, &formatProps);
+		VkFormatFeatureFlags required = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+			VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+		if ((formatProps.optimalTilingFeatures & required) != required)
+		{
+			return false;
+		}
+		if (m_headless)
+		{
+			return true;
+		}
+		VkSurfaceCapabilitiesKHR surfaceCaps{};
+		vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_gpu, m_surface, &surfaceCaps);
+		return (surfaceCaps.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT) != 0;
+	}
+
+	// ̃t[ŕ`悷͈.
+	VkExtent2D GetRenderExtent() const
+	{
+		auto extent = m_swapchainContext.dimensions;
+		if (!m_scaledRendering)
+		{
+			return extent;
+		}
+		auto scale = m_resolutionScaler.GetScale();
+		return { ResolutionScaler::Scale(extent.width, scale), ResolutionScaler::Scale(extent.height, scale) };
+	}
+
+	// ̃OtBbNXL[ւ̓A񓯊L[ point ̊܂ stage ő҂.
+	void WaitOnGraphics(const QueueSyncPoint& point, VkPipelineStageFlags stage)
+	{
+		if (point.IsValid())
+		{
+			m_graphicsWaits.push_back(QueueWait{ .point = point, .stage = stage });
+		}
+	}
+
+	// ^CCZ}tH serial ɒB܂ő҂. ς݂ƕĂΉȂ.
+	void WaitForSerial(uint64_t serial)
+	{
+		if (serial <= m_completedSerial)
+		{
+			return;
+		}
+		VkSemaphoreWaitInfo waitInfo{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+			.semaphoreCount = 1,
+			.pSemaphores = &m_timelineSemaphore,
+			.pValues = &serial,
+		};
+		m_waitSemaphores(m_vkDevice, &waitInfo, UINT64_MAX);
+		m_completedSerial = serial;
+	}
+
+	VkResult AcquireNextImage(FrameInfo& frame, uint32_t* imageIndex)
+	{
+		// ̃XbgOgpt[̊҂.
+		// ҂̂͂̃XbgȂ̂ŁÃXbg̃t[GPUŎŝ܂܂ł悢.
+		auto waitStart = FrameProfiler::Clock::now();
+		if (m_useTimeline)
+		{
+			WaitForSerial(frame.submitSerial);
+		}
+		else
+		{
+			vkWaitForFences(m_vkDevice, 1, &frame.queueSubmitFence, VK_TRUE, UINT64_MAX);
+			// L[͓Ɋ̂ŁAȑOɓt[ׂĊĂ.
+			m_completedSerial = std::max(m_completedSerial, frame.submitSerial);
+		}
+		auto waitEnd = FrameProfiler::Clock::now();
+		m_deletionQueue.Flush(m_completedSerial);
+		m_gpuAllocator.Flush(m_completedSerial);
+		m_uploadRing.BeginFrame(m_frameIndex);
+		m_descriptorHeap.BeginFrame(m_frameIndex, m_completedSerial);
+
+		ResolveFrameTimings(frame);
+		frame.timings = FrameTimings{
+			.frameNumber = m_frameNumber++,
+			.displayMode = GetDisplayModeName(),
+			.presentMode = m_headless ? "none" : GetPresentModeName(m_swapchainContext.presentMode),
+			.fenceWaitMs = FrameProfiler::ElapsedMs(waitStart, waitEnd),
+			.renderScale = m_scaledRendering ? m_resolutionScaler.GetScale() : 1.0f,
+		};
+
+		if (m_headless)
+		{
+			// ItXN[C[W͏ԂɎg.
+			*imageIndex = m_swapchainContext.nextImageIndex;
+			m_swapchainContext.nextImageIndex = (*imageIndex + 1) % uint32_t(m_swapchainContext.imageViews.size());
+		}
+		else
+		{
+			auto acquireStart = FrameProfiler::Clock::now();
+			auto res = vkAcquireNextImageKHR(m_vkDevice, m_swapchainContext.swapchain, UINT64_MAX, frame.semPresentComplete, VK_NULL_HANDLE, imageIndex);
+			frame.timings.acquireMs = FrameProfiler::ElapsedMs(acquireStart, FrameProfiler::Clock::now());
+			if (res != VK_SUCCESS)
+			{
+				auto str = std::format("vkAcquireNextImageKHR failed. (result = {:d})\n", (int)res);
+				OutputLog(str.c_str());
+				return res;
+			}
+		}
+
+		// 擾C[Wʂ̃Xbg̃t[܂gpł΁Å҂.
+		if (m_useTimeline)
+		{
+			auto& imageSerial = m_swapchainContext.imageSerials[*imageIndex];
+			if (imageSerial > m_completedSerial)
+			{
+				waitStart = FrameProfiler::Clock::now();
+				WaitForSerial(imageSerial);
+				frame.timings.fenceWaitMs += FrameProfiler::ElapsedMs(waitStart, FrameProfiler::Clock::now());
+			}
+			// ̃t[͎ɓ.
+			imageSerial = m_submitSerial + 1;
+		}
+		else
+		{
+			auto& imageFence = m_swapchainContext.imageFences[*imageIndex];
+			if (imageFence != VK_NULL_HANDLE && imageFence != frame.queueSubmitFence)
+			{
+				waitStart = FrameProfiler::Clock::now();
+				vkWaitForFences(m_vkDevice, 1, &imageFence, VK_TRUE, UINT64_MAX);
+				frame.timings.fenceWaitMs += FrameProfiler::ElapsedMs(waitStart, FrameProfiler::Clock::now());
+			}
+			imageFence = frame.queueSubmitFence;
+
+			vkResetFences(m_vkDevice, 1, &frame.queueSubmitFence);
+		}
+		if (frame.commandPool != VK_NULL_HANDLE)
+		{
+			vkResetCommandPool(m_vkDevice, frame.commandPool, 0);
+		}
+		// [J[̃v[̃Xbg̊҂Ȃ̂ł܂Ƃ߂ăZbgł.
+		for (auto& pool : frame.workerPools)
+		{
+			vkResetCommandPool(m_vkDevice, pool.commandPool, 0);
+			pool.usedCount = 0;
+		}
+
+		return VK_SUCCESS;
+	}
+	// pCvCݒ肵 firstDraw  count ̃h[L^. includeObjects ȂIuWFNg̊Ԑڕ`L^.
+	// ZJ_R}hobt@͏ԂpȂ̂ŁA񂷂ׂĐݒ肷.
+	// Zbg͍̑ŏɈxsAh[Ƃɂ̓vbV萔XV.
+	void RecordDraws(VkCommandBuffer commandBuffer, uint32_t firstDraw, uint32_t count, uint32_t frameConstantsOffset, bool includeObjects)
+	{
+		if (m_pipeline != VK_NULL_HANDLE)
+		{
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline);
+		}
+		if (auto descriptorSet = m_uploadRing.GetDescriptorSet(); descriptorSet != VK_NULL_HANDLE)
+		{
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout,
+				0, 1, &descriptorSet, 1, &frameConstantsOffset);
+		}
+		if (m_bindlessSetBound)
+		{
+			auto bindlessSet = m_descriptorHeap.GetBindlessSet();
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout,
+				BindlessSetIndex, 1, &bindlessSet, 0, nullptr);
+		}
+
+		VkViewport viewport{
+			.x = 0,
+			.y = 0,
+			.width = float(m_renderExtent.width),
+			.height = float(m_renderExtent.height),
+			.minDepth = 0.0f,
+			.maxDepth = 1.0f,
+		};
+		VkRect2D scissor{
+			.offset = { 0, 0 },
+			.extent = m_renderExtent,
+		};
+		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+		for (uint32_t i = 0; m_pipeline != VK_NULL_HANDLE && i < count; ++i)
+		{
+			vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+		}
+		if (includeObjects && m_objectCount > 0 && m_objectPipeline != VK_NULL_HANDLE)
+		{
+			m_objectRenderer.RecordDraw(commandBuffer, m_frameIndex, m_objectPipeline, m_objectView);
+		}
+	}
+
+	// ̃t[ŃAbv[h̊󂯎Ǎ͖t[\͈͂𓮂ĎJOs.
+	// 񓯊Rs[gL[΃JO͂ɓAOtBbNXL[͊Ԑڕ`̃Xe[Wł̊҂.
+	void RecordObjectCulling(VkCommandBuffer commandBuffer, FrameProfiler::Clock::time_point now)
+	{
+		if (m_objectsPendingAcquire)
+		{
+			if (m_objectsUploadOnGraphics)
+			{
+				m_objectRenderer.RecordUpload(commandBuffer, m_objectTransfer);
+			}
+			m_objectRenderer.RecordAcquire(commandBuffer, m_objectTransfer);
+			m_objectRenderer.ReleaseStaging(m_submitSerial + 1);
+			m_objectsPendingAcquire = false;
+		}
+
+		auto seconds = float(FrameProfiler::ElapsedMs(m_startTime, now) / 1000.0);
+		float aspect = float(m_swapchainContext.dimensions.width) / float(std::max(m_swapchainContext.dimensions.height, 1u));
+		m_objectView = ObjectRenderer::View{
+			.center = { std::sin(seconds * 0.2f) * ObjectRenderer::WorldExtent * 0.5f, std::cos(seconds * 0.3f) * ObjectRenderer::WorldExtent * 0.5f },
+			.scale = { 0.5f / aspect, 0.5f },
+		};
+		if (!m_useAsyncQueues)
+		{
+			m_objectRenderer.RecordCull(commandBuffer, m_frameIndex, m_objectView, m_cullTransfer);
+			return;
+		}
+
+		auto computeCommandBuffer = m_computeQueue.Begin();
+		m_objectRenderer.RecordCull(computeCommandBuffer, m_frameIndex, m_objectView, m_cullTransfer);
+		// ͓]L[ł̃Abv[h̊҂.
+		std::vector<QueueWait> waits;
+		if (m_objectsUploadPoint.IsValid())
+		{
+			waits.push_back(QueueWait{ .point = m_objectsUploadPoint, .stage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT });
+			m_objectsUploadPoint = {};
+		}
+		WaitOnGraphics(m_computeQueue.Submit(waits), VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+		m_objectRenderer.RecordAcquireCommands(commandBuffer, m_frameIndex, m_cullTransfer);
+	}
+
+	// I_Oł 1 t[̕`. CAEg̑Jڂ̓_[OtpX̑Oɒu.
+	// k`ł͕`OẗꎞC[WɂAXbv`FC̃C[W֊g傷pX𑫂.
+	// ꎞC[W̓Xbv`FCƓ傫Ȃ̂ŁA{ςĂOt͑gݒȂ.
+	void BuildRenderGraph()
+	{
+		auto& dimensions = m_swapchainContext.dimensions;
+		auto format = m_swapchainContext.format;
+		// l̃Z}tH҂Xe[Wgn߂. wbhXł͓ǂݏo(])ɎgԂŏI.
+		RenderGraph::ImageState acquired{
+			.layout = VK_IMAGE_LAYOUT_UNDEFINED,
+			.stage = m_scaledRendering ? VkPipelineStageFlags2(VK_PIPELINE_STAGE_2_TRANSFER_BIT) : VkPipelineStageFlags2(VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT),
+		};
+		RenderGraph::ImageState presented{
+			.layout = m_headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+			.stage = VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT,
+		};
+		m_swapchainResource = m_renderGraph.ImportImage("swapchain", format, dimensions, acquired, presented, true);
+		m_sceneResource = m_scaledRendering ? m_renderGraph.CreateImage("scene", format, dimensions) : m_swapchainResource;
+
+		m_renderGraph.AddPass("scene", {}, { { m_sceneResource, RenderGraph::Usage::ColorAttachment } },
+			[this](VkCommandBuffer commandBuffer) { RecordScenePass(commandBuffer); });
+		if (m_scaledRendering)
+		{
+			m_renderGraph.AddPass("upscale", { { m_sceneResource, RenderGraph::Usage::TransferSrc } }, { { m_swapchainResource, RenderGraph::Usage::TransferDst } },
+				[this](VkCommandBuffer commandBuffer) {
+					BlitScene(commandBuffer, m_renderGraph.GetImage(m_sceneResource), m_renderGraph.GetImage(m_swapchainResource));
+				});
+		}
+		if (!m_renderGraph.Compile())
+		{
+			// ꎞC[Wu΁AkɃXbv`FC֒ڕ`悷.
+			OutputLog("Render graph: failed to allocate transient images, render scale disabled.\n");
+			m_renderGraph.Reset(m_submitSerial);
+			m_scaledRendering = false;
+			BuildRenderGraph();
+			return;
+		}
+		OutputLog(m_renderGraph.FormatSummary().c_str());
+		if (!m_renderGraphDumpPath.empty())
+		{
+			std::ofstream file(m_renderGraphDumpPath, std::ios::trunc);
+			file << m_renderGraph.Dump();
+		}
+	}
+
+	// _[Ot "scene" pX. L^̃t[ m_recording Ŏ󂯎.
+	void RecordScenePass(VkCommandBuffer commandBuffer)
+	{
+		VkClearValue clearValue{};
+		clearValue.color = { { 1.0f, 0.6f, 0.5f, 1.0f,} };
+		VkRenderingAttachmentInfo colorAttachment{
+			.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+			.imageView = m_renderGraph.GetView(m_sceneResource),
+			.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+			.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+			.storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+			.clearValue = clearValue,
+		};
+		VkRenderingInfo renderingInfo{
+			.sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+			.flags = m_recording.useWorkers ? VkRenderingFlags(VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT) : 0u,
+			.renderArea = { .offset = { 0, 0 }, .extent = m_renderExtent },
+			.layerCount = 1,
+			.colorAttachmentCount = 1,
+			.pColorAttachments = &colorAttachment,
+		};
+		m_cmdBeginRendering(commandBuffer, &renderingInfo);
+		if (m_recording.useWorkers)
+		{
+			RecordSecondaryCommands(*m_recording.frame, VK_NULL_HANDLE);
+		}
+		else
+		{
+			RecordDraws(commandBuffer, 0, m_drawCount, m_recording.frame->frameConstantsOffset, true);
+		}
+		m_cmdEndRendering(commandBuffer);
+	}
+
+	// _[pXł̕`. CAEg̑Jڂ̓_[pX̃TupXˑōs.
+	void BeginRenderPass(VkCommandBuffer commandBuffer, uint32_t imageIndex, bool secondaryContents)
+	{
+		VkClearValue clearValue{};
+		clearValue.color = { { 1.0f, 0.6f, 0.5f, 1.0f,} };
+		VkRenderPassBeginInfo renderPassBI{};
+		renderPassBI.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassBI.renderPass = m_scaledRendering ? m_sceneRenderPass : m_renderPass;
+		renderPassBI.framebuffer = m_scaledRendering ? m_sceneTarget.framebuffer : m_swapchainContext.framebuffers[imageIndex];
+		renderPassBI.renderArea = { .offset = { 0, 0 }, .extent = m_renderExtent };
+		renderPassBI.pClearValues = &clearValue;
+		renderPassBI.clearValueCount = 1;
+		vkCmdBeginRenderPass(commandBuffer, &renderPassBI,
+			secondaryContents ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+	}
+
+	void EndRenderPass(VkCommandBuffer commandBuffer, uint32_t imageIndex)
+	{
+		vkCmdEndRenderPass(commandBuffer);
+		if (m_scaledRendering)
+		{
+			UpscaleToSwapchain(commandBuffer, imageIndex);
+		}
+	}
+
+	// _[pXŏkĕ`悵ʂAXbv`FC̃C[W֊g傷.
+	void UpscaleToSwapchain(VkCommandBuffer commandBuffer, uint32_t imageIndex)
+	{
+		auto image = m_swapchainContext.images[imageIndex];
+		// l̃Z}tH͓]Xe[Wő҂Ă.
+		TransitionImage(commandBuffer, image,
+			VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+		BlitScene(commandBuffer, m_sceneTarget.image, image);
+
+		// wbhXł͓ǂݏo(])ɎgԂŏI.
+		TransitionImage(commandBuffer, image,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+			VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0);
+	}
+
+	// kĕ`悵͈͂AXbv`FC̃C[WŜɐ`ԂŊg傷.
+	// src ͓]Adst ͓]̃CAEgɂĂ.
+	void BlitScene(VkCommandBuffer commandBuffer, VkImage src, VkImage dst)
+	{
+		auto& dimensions = m_swapchainContext.dimensions;
+		VkImageBlit region{
+			.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 },
+			.srcOffsets = { { 0, 0, 0 }, { int32_t(m_renderExtent.width), int32_t(m_renderExtent.height), 1 } },
+			.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 },
+			.dstOffsets = { { 0, 0, 0 }, { int32_t(dimensions.width), int32_t(dimensions.height), 1 } },
+		};
+		vkCmdBlitImage(commandBuffer, src, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			dst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region, VK_FILTER_LINEAR);
+	}
+
+	void TransitionImage(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+		VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess)
+	{
+		VkImageMemoryBarrier barrier{
+			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+			.srcAccessMask = srcAccess,
+			.dstAccessMask = dstAccess,
+			.oldLayout = oldLayout,
+			.newLayout = newLayout,
+			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.image = image,
+			.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+		};
+		vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+	}
+
+	// h[[J[̐ɕAꂼ̃[J[̃R}hv[ZJ_R}hobt@ɋL^.
+	void RecordSecondaryCommands(FrameInfo& frame, VkFramebuffer framebuffer)
+	{
+		uint32_t jobCount = std::min(m_drawCount, m_jobSystem.GetWorkerCount());
+		frame.secondaryCommandBuffers.resize(jobCount);
+
+		m_jobSystem.Dispatch(jobCount, [&](uint32_t job, uint32_t worker) {
+			auto commandBuffer = AllocateSecondaryCommandBuffer(frame.workerPools[worker]);
+			// I_Oł̓_[pX̑ɃA^b`g̃tH[}bgp.
+			VkCommandBufferInheritanceRenderingInfo renderingInfo{
+				.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+				.colorAttachmentCount = 1,
+				.pColorAttachmentFormats = &m_swapchainContext.format,
+				.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+			};
+			VkCommandBufferInheritanceInfo inheritanceInfo{
+				.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+				.pNext = m_useDynamicRendering ? &renderingInfo : nullptr,
+				.renderPass = m_renderPass,
+				.subpass = 0,
+				.framebuffer = framebuffer,
+			};
+			VkCommandBufferBeginInfo beginInfo{
+				.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+				.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+				.pInheritanceInfo = &inheritanceInfo,
+			};
+			vkBeginCommandBuffer(commandBuffer, &beginInfo);
+			uint32_t first = uint32_t(uint64_t(m_drawCount) * job / jobCount);
+			uint32_t last = uint32_t(uint64_t(m_drawCount) * (job + 1) / jobCount);
+			RecordDraws(commandBuffer, first, last - first, frame.frameConstantsOffset, job == 0);
+			vkEndCommandBuffer(commandBuffer);
+			frame.secondaryCommandBuffers[job] = commandBuffer;
+		});
+
+		vkCmdExecuteCommands(frame.commandBuffer, jobCount, frame.secondaryCommandBuffers.data());
+	}
+
+	// [J[̃XbhĂ΂. v[͂̃[J[gp.
+	VkCommandBuffer AllocateSecondaryCommandBuffer(WorkerCommandPool& pool)
+	{
+		if (pool.usedCount == pool.commandBuffers.size())
+		{
+			VkCommandBufferAllocateInfo allocateInfo{
+				.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+				.commandPool = pool.commandPool,
+				.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+				.commandBufferCount = 1,
+			};
+			VkCommandBuffer commandBuffer;
+			vkAllocateCommandBuffers(m_vkDevice, &allocateInfo, &commandBuffer);
+			pool.commandBuffers.push_back(commandBuffer);
+		}
+		return pool.commandBuffers[pool.usedCount++];
+	}
+
+	// Xbg̑Õt[̌vʂ GPU ԂĊm肷.
+	// Xbg̃tFXĂԂŌĂԂ.
+	void ResolveFrameTimings(FrameInfo& frame)
+	{
+		if (!frame.hasPendingTimings)
+		{
+			return;
+		}
+		frame.hasPendingTimings = false;
+
+		if (frame.timestampQueryPool != VK_NULL_HANDLE)
+		{
+			std::array<uint64_t, 2> timestamps{};
+			auto res = vkGetQueryPoolResults(m_vkDevice, frame.timestampQueryPool, 0, 2,
+				sizeof(timestamps), timestamps.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+			if (res == VK_SUCCESS)
+			{
+				uint64_t mask = (m_timestampValidBits >= 64) ? ~0ull : ((1ull << m_timestampValidBits) - 1);
+				uint64_t ticks = (timestamps[1] - timestamps[0]) & mask;
+				frame.timings.gpuMs = double(ticks) * m_timestampPeriod / 1000000.0;
+			}
+		}
+		m_profiler.Push(frame.timings);
+
+		// {̕ύX͎ɋL^t[甽f.
+		if (m_scaledRendering &&
+			m_resolutionScaler.Update(frame.timings.gpuMs >= 0.0 ? frame.timings.gpuMs : frame.timings.frameMs))
+		{
+			auto str = std::format("Render scale: {:.2f} (smoothed {:.3f} ms, budget {:.2f} ms)\n",
+				m_resolutionScaler.GetScale(), m_resolutionScaler.GetSmoothedMs(), m_resolutionScaler.GetBudgetMs());
+			OutputLog(str.c_str());
+		}
+	}
+
+	void WriteProfile()
+	{
+		m_profiler.Collect();
+		if (m_profiler.GetHistory().empty())
+		{
+			return;
+		}
+		OutputLog(m_profiler.BuildSummary().c_str());
+
+		if (!m_profileCsvPath.empty() && !m_profiler.WriteCsv(m_profileCsvPath))
+		{
+			auto str = std::format("Failed to write {}.\n", m_profileCsvPath);
+			OutputLog(str.c_str());
+		}
+		if (!m_profileJsonPath.empty() && !m_profiler.WriteJson(m_profileJsonPath))
+		{
+			auto str = std::format("Failed to write {}.\n", m_profileJsonPath);
+			OutputLog(str.c_str());
+		}
+	}
+
+	VkResult PresentImage(uint32_t index)
+	{
+		if (m_headless)
+		{
+			return VK_SUCCESS;
+		}
+		// x[hł́A\҂Ă悤Ƀv[gɔԍt.
+		uint64_t presentId = m_presentId + 1;
+		VkPresentIdKHR presentIdInfo{
+			.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR,
+			.swapchainCount = 1,
+			.pPresentIds = &presentId,
+		};
+		VkPresentInfoKHR present{
+			.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+			.pNext = m_usePresentWait ? &presentIdInfo : nullptr,
+			.waitSemaphoreCount = 1,
+			.pWaitSemaphores = &m_swapchainContext.renderCompleteSemaphores[index],
+			.swapchainCount = 1,
+			.pSwapchains = &m_swapchainContext.swapchain,
+			.pImageIndices = &index,
+		};
+
+		auto res = vkQueuePresentKHR(m_deviceQueue, &present);
+		if (m_usePresentWait)
+		{
+			m_presentId = presentId;
+			m_lastPresentId = (res == VK_SUCCESS || res == VK_SUBOPTIMAL_KHR) ? presentId : 0;
+		}
+		return res;
+	}
+
+	// x[hŁA͂ǂޑOɑÕt[҂. ҂ (~b) Ԃ.
+	// present wait gΕ\܂ŁAgȂ GPU ł̊܂ł҂.
+	double WaitForPreviousFrame()
+	{
+		auto waitStart = FrameProfiler::Clock::now();
+		if (m_usePresentWait && m_lastPresentId > 0)
+		{
+			// \Ȃ܂܎~܂Ȃ悤ɎԂ؂. s͎̎擾v[ǧʂň.
+			vkWaitForPresentKHR(m_vkDevice, m_swapchainContext.swapchain, m_lastPresentId, PresentWaitTimeoutNs);
+		}
+		else if (m_useTimeline)
+		{
+			WaitForSerial(m_submitSerial);
+		}
+		else
+		{
+			// 擾Ɏst[̓Xbgi߂Ȃ̂ŁAÕXbgŌɓt[.
+			auto& previous = m_frames[(m_frameIndex + m_framesInFlight - 1) % m_framesInFlight];
+			if (previous.submitSerial > m_completedSerial)
+			{
+				vkWaitForFences(m_vkDevice, 1, &previous.queueSubmitFence, VK_TRUE, UINT64_MAX);
+				m_completedSerial = previous.submitSerial;
+			}
+		}
+		return FrameProfiler::ElapsedMs(waitStart, FrameProfiler::Clock::now());
+	}
+
+	// CxgXbhĂ.
+	void UpdateApplicationWindow(Mode mode)
+	{
+		m_platform->ApplyWindowStyle(mode != Windowed);
+	}
+
+	void Resize(int width, int height)
+	{
+		if (m_vkDevice == VK_NULL_HANDLE)
+		{
+			return;
+		}
+		VkSurfaceCapabilitiesKHR surfaceCaps;
+		vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_gpu, m_surface, &surfaceCaps);
+
+		if (surfaceCaps.currentExtent.width == m_swapchainContext.dimensions.width &&
+			surfaceCaps.currentExtent.height == m_swapchainContext.dimensions.height)
+		{
+			return;
+		}
+		// ÂXbv`FC InitializeSwapchain() őޔ̂ŁAGPŮ͑҂Ȃ.
+		if (!InitializeSwapchain())
+		{
+			QueueRecovery(PresentRecovery::Action::RecreateSwapchain);
+			return;
+		}
+		InitializeFramebuffers();
+
+		// 蒼ɂ~̓t[ԊuɊ܂߂Ȃ.
+		m_lastPresentTime = {};
+		m_framePacer.Reset();
+	}
+
+	void RecreateSwapchain()
+	{
+		if (m_vkDevice == VK_NULL_HANDLE)
+		{
+			return;
+		}
+		auto recreateStart = FrameProfiler::Clock::now();
+		if (!InitializeSwapchain())
+		{
+			// ŏȂǂōȂԂ́Ãt[̑Oɍ蒼.
+			QueueRecovery(PresentRecovery::Action::RecreateSwapchain);
+			return;
+		}
+		InitializeFramebuffers();
+		{
+			auto recreateMs = FrameProfiler::ElapsedMs(recreateStart, FrameProfiler::Clock::now());
+			m_recreateTimings.push_back(recreateMs);
+			auto str = std::format("Swapchain recreated in {:.3f} ms ({} deletions pending).\n",
+				recreateMs, m_deletionQueue.GetPendingCount());
+			OutputLog(str.c_str());
+		}
+
+		// EBhẼX^CύX̓CxgXbhɈ˗.
+		// rtXN[̎擾͂̊ɍs.
+		if (m_window != nullptr && m_windowMode != m_mode)
+		{
+			while (!m_windowUpdates.Push(m_mode))
+			{
+				std::this_thread::yield();
+			}
+			glfwPostEmptyEvent();
+		}
+
+		if (isExclusiveFullscreen() && m_windowMode == ExclusiveFullscreen)
+		{
+			AcquireFullScreenExclusive();
+		}
+
+		// 蒼ɂ~̓t[ԊuɊ܂߂Ȃ.
+		m_lastPresentTime = {};
+		m_framePacer.Reset();
+	}
+
+	void AcquireFullScreenExclusive()
+	{
+		if (m_swapchainContext.swapchain != VK_NULL_HANDLE)
+		{
+			m_platform->AcquireFullScreenExclusive(m_vkDevice, m_swapchainContext.swapchain);
+		}
+	}
+
+	// ݒ肳ꂽD揇ŁAT|[gĂŏ̃v[g[hI.
+	VkPresentModeKHR SelectPresentMode() const
+	{
+		auto& supported = m_swapchainContext.presentModes;
+		for (auto mode : m_presentModePreference)
+		{
+			if (std::ranges::find(supported, mode) != supported.end())
+			{
+				return mode;
+			}
+		}
+		// FIFO ͂ǂ̊łT|[gĂ.
+		return VK_PRESENT_MODE_FIFO_KHR;
+	}
+
+	// T|[gĂv[g[hԂɐ؂ւ.
+	void CyclePresentMode()
+	{
+		auto& supported = m_swapchainContext.presentModes;
+		if (supported.size() < 2)
+		{
+			return;
+		}
+		auto current = m_swapchainContext.presentMode;
+		if (auto it = m_presentModeStats.find(current); it != m_presentModeStats.end())
+		{
+			ReportFramePacing(current, it->second);
+		}
+
+		auto it = std::ranges::find(supported, current);
+		if (it == supported.end() || ++it == supported.end())
+		{
+			it = supported.begin();
+		}
+		m_swapchainContext.presentMode = *it;
+		RecreateSwapchain();
+
+		auto str = std::format("Present mode: {}\n", GetPresentModeName(m_swapchainContext.presentMode));
+		OutputLog(str.c_str());
+	}
+
+	// Õv[g̊Ԋũ݂v[g[h̓vɉ.
+	void RecordFramePacing()
+	{
+		if (m_headless)
+		{
+			return;
+		}
+		auto now = std::chrono::steady_clock::now();
+		if (m_lastPresentTime != std::chrono::steady_clock::time_point{})
+		{
+			double intervalMs = std::chrono::duration<double, std::milli>(now - m_lastPresentTime).count();
+			auto& stats = m_presentModeStats[m_swapchainContext.presentMode];
+			stats.frameCount++;
+			stats.totalMs += intervalMs;
+			stats.totalSquaredMs += intervalMs * intervalMs;
+			stats.maxMs = std::max(stats.maxMs, intervalMs);
+		}
+		m_lastPresentTime = now;
+	}
+
+	static void ReportFramePacing(VkPresentModeKHR mode, const FramePacingStats& stats)
+	{
+		if (stats.frameCount == 0)
+		{
+			return;
+		}
+		double average = stats.totalMs / stats.frameCount;
+		double variance = std::max(0.0, stats.totalSquaredMs / stats.frameCount - average * average);
+		auto str = std::format("Frame pacing [{}]: {:d} frames, avg {:.3f} ms, stddev {:.3f} ms, max {:.3f} ms\n",
+			GetPresentModeName(mode), stats.frameCount, average, std::sqrt(variance), stats.maxMs);
+		OutputLog(str.c_str());
+	}
+
+	static VkBool32 VKAPI_CALL VulkanDebugCallback(
+		VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+		VkDebugUtilsMessageTypeFlagsEXT messageType,
+		const VkDebugUtilsMessengerCallbackDataEXT* data,
+		void* userData )
+	{
+		if (messageSeverity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
+		{
+			OutputLog(data->pMessage);
+		}
+		return VK_FALSE;
+	}
+
+	void OnKeyDown(int key, int mods)
+	{
+
+		if (key == GLFW_KEY_ESCAPE)
+		{
+			glfwSetWindowShouldClose(m_window, GLFW_TRUE);
+			return;
+		}
+		else if (key == GLFW_KEY_F1)
+		{
+			RequestDisplayMode(Windowed);
+		}
+		else if (key == GLFW_KEY_F2)
+		{
+			RequestDisplayMode(BorderlessFullscreen);
+		}
+		else if (key == GLFW_KEY_F3)
+		{
+			RequestDisplayMode(ExclusiveFullscreen);
+		}
+		else if (key == GLFW_KEY_F4)
+		{
+			PushRenderCommand({ .type = RenderCommand::CyclePresentMode });
+		}
+
+	}
+	// CxgXbhĂ. ȓrȂǂŕ`Xbh[hς邱Ƃ̂ŁA
+	// ݂̃[hƂ̔r͕`Xbhōs.
+	void RequestDisplayMode(Mode mode)
+	{
+		PushRenderCommand({ .type = RenderCommand::SetDisplayMode, .mode = mode });
+	}
+
+	// CxgXbhĂ. L[󂭂܂ő҂A`XbhIĂΎ̂Ă.
+	void PushRenderCommand(const RenderCommand& command)
+	{
+		while (!m_renderCommands.Push(command))
+		{
+			if (m_renderThreadExited)
+			{
+				return;
+			}
+			std::this_thread::yield();
+		}
+	}
+
+	// `XbhŃt[̐擪ɌĂ.
+	void ProcessRenderCommands()
+	{
+		RenderCommand command;
+		while (m_renderCommands.Pop(command))
+		{
+			switch (command.type)
+			{
+			case RenderCommand::SetDisplayMode:
+				// ɂ̃[hȂ牽Ȃ. A̓rłĂ.
+				if (command.mode == m_mode)
+				{
+					break;
+				}
+				// p҂̑I񂾃[hD悵AA̓rł΂߂.
+				m_recovery.Cancel();
+				m_pendingRecovery = PresentRecovery::Action::None;
+				if (command.mode == Windowed)
+				{
+					EnterWindowMode();
+				}
+				else if (command.mode == BorderlessFullscreen)
+				{
+					EnterBorderlessFullscreen();
+				}
+				else
+				{
+					EnterExclusiveFullscreen();
+				}
+				break;
+			case RenderCommand::CyclePresentMode:
+				CyclePresentMode();
+				break;
+			case RenderCommand::Resize:
+				Resize(command.width, command.height);
+				break;
+			case RenderCommand::WindowUpdated:
+				m_windowMode = command.mode;
+				if (m_mode == ExclusiveFullscreen && m_windowMode == ExclusiveFullscreen)
+				{
+					AcquireFullScreenExclusive();
+				}
+				break;
+			case RenderCommand::FocusChanged:
+				QueueRecovery(m_recovery.OnFocusChanged(command.focused));
+				break;
+			case RenderCommand::Quit:
+				m_quitRequested = true;
+				break;
+			}
+		}
+	}
+
+	bool isFullscreen() const
+	{
+		return m_mode != Windowed;
+	}
+	const char* GetDisplayModeName() const
+	{
+		if (m_headless)
+		{
+			return "headless";
+		}
+		switch (m_mode)
+		{
+		case BorderlessFullscreen:
+			return "borderless";
+		case ExclusiveFullscreen:
+			return "exclusive";
+		default:
+			return "windowed";
+		}
+	}
+	bool isExclusiveFullscreen() const
+	{
+		return m_platform->GetFullScreenExclusive() == Platform::FullScreenExclusive::ApplicationControlled;
+	}
+private:
+	// (t[CtCg)̃XbgƂ̃\[X.
+	// [J[Xbh1̃R}hv[ƁAmۂZJ_R}hobt@.
+	struct WorkerCommandPool
+	{
+		VkCommandPool commandPool = VK_NULL_HANDLE;
+		std::vector<VkCommandBuffer> commandBuffers;
+		// ̃t[Ŏgpς݂̐.
+		size_t usedCount = 0;
+	};
+	struct FrameInfo
+	{
+		VkCommandPool commandPool = VK_NULL_HANDLE;
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+		VkFence queueSubmitFence = VK_NULL_HANDLE;
+		VkSemaphore semPresentComplete = VK_NULL_HANDLE;
+		VkDevice device = VK_NULL_HANDLE;
+		uint32_t queueIndex = 0;
+
+		// _[pXÕ^CX^v(2).
+		VkQueryPool timestampQueryPool = VK_NULL_HANDLE;
+		// ̃XbgōŌɕ`悵t[̌v.
+		FrameTimings timings;
+		bool hasPendingTimings = false;
+		// ̃XbgōŌɓt[̒ʂԍ. 0 ͖.
+		uint64_t submitSerial = 0;
+
+		// [J[XbhƂ̃R}hv[([J[̔ԍ).
+		std::vector<WorkerCommandPool> workerPools;
+		// [J[L^ZJ_R}hobt@(Wu̔ԍ).
+		std::vector<VkCommandBuffer> secondaryCommandBuffers;
+		// Abv[hÕt[萔̓IItZbg.
+		uint32_t frameConstantsOffset = 0;
+	};
+	// t[ƂɃAbv[hO֏ޒ萔 (std140 ̕).
+	struct FrameConstants
+	{
+		float time;
+		uint32_t frameIndex;
+		float viewportSize[2];
+	};
+	struct SwapchainContext
+	{
+		VkExtent2D dimensions{};
+		VkFormat   format = VK_FORMAT_UNDEFINED;
+		VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+		// Xbv`FC܂̓ItXN[̃C[W (LȂ).
+		std::vector<VkImage> images;
+		std::vector<VkImageView> imageViews;
+		// C[WƂ̕`抮̃Z}tH. v[g҂.
+		std::vector<VkSemaphore> renderCompleteSemaphores;
+		std::vector<VkFramebuffer> framebuffers;
+		// C[WƂɁAŌɂ̃C[Wgpt[̃tFX(LȂ).
+		std::vector<VkFence> imageFences;
+		// ^CCZ}tHgꍇ́AtFX̑Ƀt[̒ʂԍL^.
+		std::vector<uint64_t> imageSerials;
+
+		VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR;
+		// T[tFXT|[gĂv[g[h(؂ւ).
+		std::vector<VkPresentModeKHR> presentModes;
+
+		// wbhX쎞ɃXbv`FC̑ɎgC[W.
+		std::vector<VkImage> offscreenImages;
+		std::vector<GpuAllocation> offscreenAllocations;
+		uint32_t nextImageIndex = 0;
+	};
+
+	// foCXLnh̔j́At[̒ʂԍgĂŒx.
+	DeletionQueue m_deletionQueue;
+	GpuAllocator m_gpuAllocator;
+	UploadRing m_uploadRing;
+	FrameProfiler::Clock::time_point m_startTime;
+	static constexpr VkDeviceSize UploadRingSizePerFrame = 1ull << 20;
+	static constexpr uint32_t PipelineCompileThreads = 2;
+	// ^CCZ}tH̒lɂ̓t[̒ʂԍ̂܂܎g.
+	bool m_useTimeline = true;
+	VkSemaphore m_timelineSemaphore = VK_NULL_HANDLE;
+	PFN_vkWaitSemaphores m_waitSemaphores = nullptr;
+	PFN_vkGetSemaphoreCounterValue m_getSemaphoreCounterValue = nullptr;
+	bool m_useDynamicRendering = true;
+	PFN_vkCmdBeginRendering m_cmdBeginRendering = nullptr;
+	PFN_vkCmdEndRendering m_cmdEndRendering = nullptr;
+	bool m_useBindless = true;
+	DescriptorHeap m_descriptorHeap;
+	// m_pipelineLayout ɃoChX̃Zbg܂߂.
+	bool m_bindlessSetBound = false;
+	static constexpr uint32_t BindlessSetIndex = 1;
+
+	// 񓯊Rs[gƓ]. p̃t@~[ꍇ̓OtBbNX̃t@~[̃L[g.
+	bool m_useAsyncQueues = true;
+	uint32_t m_computeQueueFamily = 0;
+	uint32_t m_computeQueueIndex = 0;
+	uint32_t m_transferQueueFamily = 0;
+	uint32_t m_transferQueueIndex = 0;
+	AsyncQueue m_computeQueue;
+	AsyncQueue m_transferQueue;
+
+	uint32_t m_objectCount = 0;
+	ObjectRenderer m_objectRenderer;
+	ObjectRenderer::View m_objectView{};
+	QueueOwnershipTransfer m_objectTransfer{};
+	// JǑʂRs[gL[OtBbNXL[֓n.
+	QueueOwnershipTransfer m_cullTransfer{};
+	QueueSyncPoint m_objectsUploadPoint;
+	bool m_objectsUploadOnGraphics = false;
+	bool m_objectsPendingAcquire = false;
+
+	std::string m_shaderDirectory;
+	ShaderLibrary m_shaderLibrary;
+	PipelineManager m_pipelineManager;
+	// `ɎgpCvC̏. ̂̓t[Ƃ m_pipelineManager o.
+	GraphicsPipelineState m_pipelineState;
+	GraphicsPipelineState m_objectPipelineState;
+	VkPipeline m_objectPipeline = VK_NULL_HANDLE;
+	FrameProfiler::Clock::time_point m_pipelineRequestTime;
+	std::vector<QueueWait> m_graphicsWaits;
+	uint32_t m_instanceApiVersion = VK_API_VERSION_1_0;
+	std::string m_gpuOverride;
+	uint64_t m_submitSerial = 0;
+	uint64_t m_completedSerial = 0;
+
+	GLFWwindow* m_window = nullptr;
+	VkInstance m_vkInstance = VK_NULL_HANDLE;
+	VkDevice   m_vkDevice = VK_NULL_HANDLE;
+	VkDebugUtilsMessengerEXT m_debugUtils = VK_NULL_HANDLE;
+	VkPhysicalDevice m_gpu = VK_NULL_HANDLE;
+	uint32_t m_graphicsQueueIndex = 0;
+	VkQueue m_deviceQueue = VK_NULL_HANDLE;
+	VkSurfaceKHR m_surface = VK_NULL_HANDLE;
+	SwapchainContext m_swapchainContext;
+	std::vector<FrameInfo>   m_frames{};
+	uint32_t m_framesInFlight = 2;
+	uint32_t m_frameIndex = 0;
+
+	bool m_headless = false;
+	VkExtent2D m_headlessExtent{};
+	uint64_t m_frameLimit = 0;
+	uint32_t m_swapchainImageCount = 0;
+	uint32_t m_modeSwitchInterval = 0;
+	// RecreateSwapchain() Ƃ̏v (~b).
+	std::vector<double> m_recreateTimings;
+	static constexpr uint32_t HeadlessImageCount = 3;
+
+	// v[g[hƂ̃t[Ԋu̓v.
+	struct FramePacingStats
+	{
+		uint64_t frameCount = 0;
+		double totalMs = 0.0;
+		double totalSquaredMs = 0.0;
+		double maxMs = 0.0;
+	};
+	std::vector<VkPresentModeKHR> m_presentModePreference;
+	std::map<VkPresentModeKHR, FramePacingStats> m_presentModeStats;
+	std::chrono::steady_clock::time_point m_lastPresentTime{};
+
+	// t[[g̐ƒx[h.
+	FramePacer m_framePacer;
+	bool m_lowLatency = false;
+	bool m_usePresentWait = false;
+	// Ōɕtv[g̔ԍƁA\҂ĂŌ̔ԍ (0 Ȃ疳).
+	uint64_t m_presentId = 0;
+	uint64_t m_lastPresentId = 0;
+	static constexpr uint64_t PresentWaitTimeoutNs = 100'000'000;
+
+	FrameProfiler m_profiler;
+	uint64_t m_frameNumber = 0;
+	float m_timestampPeriod = 1.0f;
+	uint32_t m_timestampValidBits = 0;
+	std::string m_profileCsvPath;
+	std::string m_profileJsonPath;
+	static constexpr uint64_t ProfileCollectInterval = 256;
+	VkRenderPass m_renderPass = VK_NULL_HANDLE;
+
+	// k`. `̓Xbv`FC̍蒼ɍ킹č蒼.
+	struct SceneTarget
+	{
+		VkImage image = VK_NULL_HANDLE;
+		GpuAllocation allocation;
+		VkImageView view = VK_NULL_HANDLE;
+		VkFramebuffer framebuffer = VK_NULL_HANDLE;
+	};
+	bool m_scaledRendering = false;
+	ResolutionScaler m_resolutionScaler;
+	SceneTarget m_sceneTarget;
+	VkRenderPass m_sceneRenderPass = VK_NULL_HANDLE;
+
+	// I_O̕`̓_[OtŋL^. synchronization2  m_cmdPipelineBarrier2  nullptr.
+	RenderGraph m_renderGraph;
+	RenderGraph::ResourceId m_swapchainResource = RenderGraph::InvalidResource;
+	RenderGraph::ResourceId m_sceneResource = RenderGraph::InvalidResource;
+	PFN_vkCmdPipelineBarrier2 m_cmdPipelineBarrier2 = nullptr;
+	std::string m_renderGraphDumpPath;
+	// Execute() ̊ԂApX̋L^Ɏgt[w.
+	struct RecordingState
+	{
+		FrameInfo* frame = nullptr;
+		bool useWorkers = false;
+	};
+	RecordingState m_recording;
+	// `L^̃t[ŕ`悷͈.
+	VkExtent2D m_renderExtent{};
+	VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+	VkPipeline m_pipeline = VK_NULL_HANDLE;
+	PipelineCache m_pipelineCache;
+	JobSystem m_jobSystem;
+	uint32_t m_drawCount = 1;
+	std::string m_pipelineCachePath;
+
+	// `XbhL錻݂̉ʃ[h.
+	Mode m_mode = Windowed;
+
+	// CxgXbh`Xbh֑v.
+	struct RenderCommand
+	{
+		enum Type
+		{
+			SetDisplayMode,
+			CyclePresentMode,
+			Resize,
+			// CxgXbhEBhẼX^CύXI.
+			WindowUpdated,
+			FocusChanged,
+			Quit,
+		};
+		Type type = Quit;
+		Mode mode = Windowed;
+		int width = 0;
+		int height = 0;
+		bool focused = false;
+	};
+	SpscRingBuffer<RenderCommand, 64> m_renderCommands;
+	// `XbhCxgXbhցAEBhEX^C̕ύX˗.
+	SpscRingBuffer<Mode, 16> m_windowUpdates;
+	// `XbhcĂAEBhẼX^Cfς݂̉ʃ[h.
+	Mode m_windowMode = Windowed;
+	bool m_quitRequested = false;
+	std::atomic<bool> m_renderThreadExited{ false };
+	// EBhEX^CƔrtXN[ OS Ƃ̏.
+	std::unique_ptr<Platform> m_platform = CreatePlatform();
+	// 擾Ev[g̎s̕AƁÃt[̑Oɍsu.
+	PresentRecovery m_recovery;
+	PresentRecovery::Action m_pendingRecovery = PresentRecovery::Action::None;
+	static constexpr int MinimizedPollIntervalMs = 16;
+
+	void InitPerFrame(FrameInfo& frameInfo)
+	{
+		VkFenceCreateInfo fenceCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+			.flags = VK_FENCE_CREATE_SIGNALED_BIT,
+		};
+		// ^CCZ}tHő҂ꍇAt[Ƃ̃tFX͕sv.
+		if (!m_useTimeline)
+		{
+			vkCreateFence(m_vkDevice, &fenceCreateInfo, nullptr, &frameInfo.queueSubmitFence);
+			m_deletionQueue.Track(frameInfo.queueSubmitFence);
+		}
+
+		VkSemaphoreCreateInfo semaphoreCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO
+		};
+		vkCreateSemaphore(m_vkDevice, &semaphoreCreateInfo, nullptr, &frameInfo.semPresentComplete);
+		m_deletionQueue.Track(frameInfo.semPresentComplete);
+
+		VkCommandPoolCreateInfo commandPoolCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+			.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+			.queueFamilyIndex = m_graphicsQueueIndex,
+		};
+		vkCreateCommandPool(m_vkDevice, &commandPoolCreateInfo, nullptr, &frameInfo.commandPool);
+		m_deletionQueue.Track(frameInfo.commandPool);
+
+		// R}hv[͊OKvȂ̂ŁA[J[Ƃɕʂ̃v[g.
+		frameInfo.workerPools.resize(m_jobSystem.GetWorkerCount());
+		for (auto& pool : frameInfo.workerPools)
+		{
+			vkCreateCommandPool(m_vkDevice, &commandPoolCreateInfo, nullptr, &pool.commandPool);
+			m_deletionQueue.Track(pool.commandPool);
+		}
+
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+			.commandPool = frameInfo.commandPool,
+			.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+			.commandBufferCount = 1,
+		};
+		vkAllocateCommandBuffers(m_vkDevice, &commandBufferAllocateInfo, &frameInfo.commandBuffer);
+		frameInfo.device = m_vkDevice;
+		frameInfo.queueIndex = m_graphicsQueueIndex;
+
+		if (m_timestampValidBits > 0)
+		{
+			VkQueryPoolCreateInfo queryPoolCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+				.queryType = VK_QUERY_TYPE_TIMESTAMP,
+				.queryCount = 2,
+			};
+			vkCreateQueryPool(m_vkDevice, &queryPoolCreateInfo, nullptr, &frameInfo.timestampQueryPool);
+			m_deletionQueue.Track(frameInfo.timestampQueryPool);
+		}
+	}
+	void TeardownPerFrame(FrameInfo& frameInfo)
+	{
+		// ̃XbgŌɓt[̊ɔj.
+		// R}hobt@̓R}hv[ƈꏏɉ.
+		auto serial = frameInfo.submitSerial;
+		m_deletionQueue.Destroy(frameInfo.queueSubmitFence, serial);
+		m_deletionQueue.Destroy(frameInfo.semPresentComplete, serial);
+		m_deletionQueue.Destroy(frameInfo.commandPool, serial);
+		frameInfo.commandBuffer = VK_NULL_HANDLE;
+		m_deletionQueue.Destroy(frameInfo.timestampQueryPool, serial);
+		for (auto& pool : frameInfo.workerPools)
+		{
+			m_deletionQueue.Destroy(pool.commandPool, serial);
+		}
+		frameInfo.workerPools.clear();
+		frameInfo.secondaryCommandBuffers.clear();
+		frameInfo.hasPendingTimings = false;
+
+		frameInfo.device = VK_NULL_HANDLE;
+		frameInfo.queueIndex = 0;
+	}
+
+	void TeardownFramebuffers()
+	{
+		for (auto& fb : m_swapchainContext.framebuffers)
+		{
+			m_deletionQueue.Destroy(fb, m_submitSerial);
+		}
+		m_swapchainContext.framebuffers.clear();
+
+		m_deletionQueue.Destroy(m_sceneTarget.framebuffer, m_submitSerial);
+		m_deletionQueue.Destroy(m_sceneTarget.view, m_submitSerial);
+		m_deletionQueue.Destroy(m_sceneTarget.image, m_submitSerial);
+		m_gpuAllocator.Free(m_sceneTarget.allocation, m_submitSerial);
+		m_sceneTarget = {};
+		m_renderGraph.Reset(m_submitSerial);
+	}
+
+	// `XbhĂ.
+	void CycleDisplayMode()
+	{
+		switch (m_mode)
+		{
+		case Windowed:
+			EnterBorderlessFullscreen();
+			break;
+		case BorderlessFullscreen:
+			EnterExclusiveFullscreen();
+			break;
+		default:
+			EnterWindowMode();
+			break;
+		}
+	}
+
+	void EnterWindowMode()
+	{
+		if (m_mode == Windowed)
+		{
+			return;
+		}
+
+		ReleaseFullScreenExclusive();
+		m_platform->SetFullScreenExclusive(Platform::FullScreenExclusive::Disallowed);
+
+		m_mode = Windowed;
+		RecreateSwapchain();
+	}
+	void EnterBorderlessFullscreen()
+	{
+		if (m_mode == BorderlessFullscreen)
+		{
+			return;
+		}
+		ReleaseFullScreenExclusive();
+		m_platform->SetFullScreenExclusive(Platform::FullScreenExclusive::Allowed);
+
+		m_mode = BorderlessFullscreen;
+
+		RecreateSwapchain();
+	}
+	void EnterExclusiveFullscreen()
+	{
+		if (m_mode == ExclusiveFullscreen)
+		{
+			return;
+		}
+		m_mode = ExclusiveFullscreen;
+		m_platform->SetFullScreenExclusive(Platform::FullScreenExclusive::ApplicationControlled);
+		RecreateSwapchain();
+	}
+	void ReleaseFullScreenExclusive()
+	{
+		if (isExclusiveFullscreen() && m_swapchainContext.swapchain != VK_NULL_HANDLE)
+		{
+			// ÕZbg.
+			m_platform->ReleaseFullScreenExclusive(m_vkDevice, m_swapchainContext.swapchain);
+		}
+	}
+};
+
+inline void FullscreenExclusiveApp::KeyProcessCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+	auto* app = static_cast<FullscreenExclusiveApp*>(glfwGetWindowUserPointer(window));
+	if (app != nullptr)
+	{
+		if (action == GLFW_PRESS)
+		{
+			app->OnKeyDown(key, mods);
+		}
+	}
+}
+
+inline void FullscreenExclusiveApp::WindowSizeCallback(GLFWwindow* window, int width, int height)
+{
+	auto* app = static_cast<FullscreenExclusiveApp*>(glfwGetWindowUserPointer(window));
+	if (app != nullptr)
+	{
+		app->PushRenderCommand({ .type = RenderCommand::Resize, .width = width, .height = height });
+	}
+}
+
+inline void FullscreenExclusiveApp::WindowFocusCallback(GLFWwindow* window, int focused)
+{
+	auto* app = static_cast<FullscreenExclusiveApp*>(glfwGetWindowUserPointer(window));
+	if (app != nullptr)
+	{
+		app->PushRenderCommand({ .type = RenderCommand::FocusChanged, .focused = focused == GLFW_TRUE });
+	}
+}
+
+
+// l̈ [minValue, maxValue] ͈̔͂ŉ߂. ߂łȂ͈͊OȂL^Avalue ͕ς false Ԃ.
+template <typename T>
+inline bool ParseNumber(std::string_view option, std::string_view text, T minValue, T maxValue, T* value)
+{
+	T parsed{};
+	auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), parsed);
+	if (ec != std::errc{} || end != text.data() + text.size() || parsed < minValue || parsed > maxValue)
+	{
+		auto str = std::format("Invalid value '{}' for {} (expected {} to {}).\n", text, option, minValue, maxValue);
+		OutputLog(str.c_str());
+		return false;
+	}
+	*value = parsed;
+	return true;
+}
+
+// R}hCNݒ쐬. sȒl΋L^ false Ԃ.
+inline bool ParseCommandLine(const std::vector<std::string>& args, FullscreenExclusiveApp::AppSettings* result)
+{
+	// wbhX̉𑜓x̏.  GPU  maxImageDimension2D ɍ킹.
+	constexpr uint32_t MaxImageExtent = 16384;
+	FullscreenExclusiveApp::AppSettings settings;
+	bool valid = true;
+	for (size_t i = 0; i < args.size(); ++i)
+	{
+		const auto& arg = args[i];
+		bool hasValue = (i + 1) < args.size();
+		if (arg == "--frames-in-flight" && hasValue)
+		{
+			valid &= ParseNumber(arg, args[++i], 1u, FullscreenExclusiveApp::MaxFramesInFlight, &settings.framesInFlight);
+		}
+		else if (arg == "--headless")
+		{
+			settings.headless = true;
+		}
+		else if (arg == "--frames" && hasValue)
+		{
+			valid &= ParseNumber(arg, args[++i], uint64_t(0), UINT64_MAX, &settings.frameCount);
+		}
+		else if (arg == "--width" && hasValue)
+		{
+			valid &= ParseNumber(arg, args[++i], 1u, MaxImageExtent, &settings.width);
+		}
+		else if (arg == "--height" && hasValue)
+		{
+			valid &= ParseNumber(arg, args[++i], 1u, MaxImageExtent, &settings.height);
+		}
+		else if (arg == "--profile-csv" && hasValue)
+		{
+			settings.profileCsvPath = args[++i];
+		}
+		else if (arg == "--profile-json" && hasValue)
+		{
+			settings.profileJsonPath = args[++i];
+		}
+		else if (arg == "--pipeline-cache" && hasValue)
+		{
+			settings.pipelineCachePath = args[++i];
+		}
+		else if (arg == "--no-pipeline-cache")
+		{
+			settings.pipelineCachePath.clear();
+		}
+		else if (arg == "--record-threads" && hasValue)
+		{
+			valid &= ParseNumber(arg, args[++i], 0u, 64u, &settings.recordThreads);
+		}
+		else if (arg == "--draws" && hasValue)
+		{
+			valid &= ParseNumber(arg, args[++i], 1u, 1000000u, &settings.drawCount);
+		}
+		else if (arg == "--swapchain-images" && hasValue)
+		{
+			valid &= ParseNumber(arg, args[++i], 0u, 16u, &settings.swapchainImageCount);
+		}
+		else if (arg == "--mode-switch-interval" && hasValue)
+		{
+			valid &= ParseNumber(arg, args[++i], 0u, UINT32_MAX, &settings.modeSwitchInterval);
+		}
+		else if (arg == "--no-dynamic-rendering")
+		{
+			settings.useDynamicRendering = false;
+		}
+		else if (arg == "--no-bindless")
+		{
+			settings.useBindless = false;
+		}
+		else if (arg == "--render-graph-dump" && hasValue)
+		{
+			settings.renderGraphDumpPath = args[++i];
+		}
+		else if (arg == "--fps-limit" && hasValue)
+		{
+			valid &= ParseNumber(arg, args[++i], 0.0, 10000.0, &settings.frameRateLimit);
+		}
+		else if (arg == "--low-latency")
+		{
+			settings.lowLatency = true;
+		}
+		else if (arg == "--shader-dir" && hasValue)
+		{
+			settings.shaderDirectory = args[++i];
+		}
+		else if (arg == "--objects" && hasValue)
+		{
+			valid &= ParseNumber(arg, args[++i], 0u, 16u << 20, &settings.objectCount);
+		}
+		else if (arg == "--inject-fault" && hasValue)
+		{
+			settings.faultInjection = args[++i];
+		}
+		else if (arg == "--render-scale" && hasValue)
+		{
+			valid &= ParseNumber(arg, args[++i], 0.25f, 1.0f, &settings.renderScale);
+		}
+		else if (arg == "--min-render-scale" && hasValue)
+		{
+			valid &= ParseNumber(arg, args[++i], 0.25f, 1.0f, &settings.minRenderScale);
+		}
+		else if (arg == "--frame-budget-ms" && hasValue)
+		{
+			valid &= ParseNumber(arg, args[++i], 0.0, 1000.0, &settings.frameBudgetMs);
+		}
+		else if (arg == "--no-async-queues")
+		{
+			settings.useAsyncQueues = false;
+		}
+		else if (arg == "--gpu" && hasValue)
+		{
+			settings.gpuOverride = args[++i];
+		}
+		else if (arg == "--sync" && hasValue)
+		{
+			// fence ܂ timeline.
+			auto& mode = args[++i];
+			if (mode != "fence" && mode != "timeline")
+			{
+				auto str = std::format("Invalid value '{}' for {} (expected timeline or fence).\n", mode, arg);
+				OutputLog(str.c_str());
+				valid = false;
+				continue;
+			}
+			settings.useTimelineSemaphore = (mode == "timeline");
+		}
+		else if (arg == "--present-mode" && hasValue)
+		{
+			// J}؂ŗD揇Ɏw肷 (: mailbox,immediate,fifo).
+			settings.presentModes.clear();
+			std::string list = args[++i];
+			for (size_t begin = 0; begin <= list.size();)
+			{
+				size_t end = std::min(list.find(',', begin), list.size());
+				auto name = list.substr(begin, end - begin);
+				auto it = std::ranges::find_if(PresentModeNames, [&](auto& v) { return name == v.second; });
+				if (it == std::end(PresentModeNames))
+				{
+					auto str = std::format("Unknown present mode '{}' for {}.\n", name, arg);
+					OutputLog(str.c_str());
+					valid = false;
+				}
+				else
+				{
+					settings.presentModes.push_back(it->first);
+				}
+				begin = end + 1;
+			}
+		}
+		else
+		{
+			// Ԃ̌Ŋl̂܂܋NȂ悤A߂łȂ͋ۂ.
+			auto str = hasValue ? std::format("Unknown option '{}'.\n", arg) : std::format("Unknown option '{}' or missing value.\n", arg);
+			OutputLog(str.c_str());
+			valid = false;
+		}
+	}
+	*result = settings;
+	return valid;
+}
@@ -0,0 +1,331 @@
+#pragma once
+
+#include "Volk/volk.h"
+#include "DeletionQueue.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <deque>
+#include <format>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+// GpuAllocator 犄蓖ĂfoCX͈̔.
+struct GpuAllocation
+{
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+	VkDeviceSize offset = 0;
+	// vꂽTCY.
+	VkDeviceSize size = 0;
+	// zXg猩郁ȂɃ}bvĂ. offset Kpς.
+	void* mapped = nullptr;
+
+	// ȉ͉̂߂̊Ǘ.
+	uint32_t poolKey = 0;
+	// UINT32_MAX Ȃp VkDeviceMemory (dedicated).
+	uint32_t blockIndex = UINT32_MAX;
+	VkDeviceSize reservedSize = 0;
+
+	bool IsValid() const { return memory != VK_NULL_HANDLE; }
+};
+
+// ^CvƂɂ܂Ƃ߂ĊmۂubN烊\[Xp̃؂o.
+// 2 ׂ̂̃TCYŕEofBAP[^Ŋ蓖Ă.
+// t[gꎞf[^́Amۂobt@ UploadRing t[̃XbgƂɕĎg.
+// ̓t[̒ʂԍƈꏏɗ\񂵁AFlush() ł̃t[̊`_ōėp.
+class GpuAllocator
+{
+public:
+	struct Stats
+	{
+		uint64_t blockCount = 0;
+		VkDeviceSize blockBytes = 0;
+		uint64_t allocationCount = 0;
+		uint64_t dedicatedCount = 0;
+		// vꂽTCY̍v.
+		VkDeviceSize usedBytes = 0;
+		// 2 ׂ̂ւ̐؂グƃACgŖʂɂȂTCY.
+		VkDeviceSize wastedBytes = 0;
+	};
+
+	void Initialize(VkDevice device, VkPhysicalDevice gpu, DeletionQueue& deletionQueue)
+	{
+		m_device = device;
+		m_deletionQueue = &deletionQueue;
+		vkGetPhysicalDeviceMemoryProperties(gpu, &m_memoryProperties);
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(gpu, &properties);
+		m_maxAllocationCount = properties.limits.maxMemoryAllocationCount;
+		m_bufferImageGranularity = properties.limits.bufferImageGranularity;
+	}
+
+	// serial ͔j\񂷂t[̒ʂԍ. foCXAChɂȂĂĂԂ.
+	void Shutdown(uint64_t serial)
+	{
+		Flush(UINT64_MAX);
+		for (auto& [key, pool] : m_pools)
+		{
+			for (auto& block : pool.blocks)
+			{
+				m_deletionQueue->Destroy(block->memory, serial);
+			}
+		}
+		m_pools.clear();
+	}
+
+	uint32_t FindMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const
+	{
+		for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; ++i)
+		{
+			if ((memoryTypeBits & (1u << i)) && (m_memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+			{
+				return i;
+			}
+		}
+		// ]̃vpeB^Cv΁Agp\ȍŏ̃^Cvɂ.
+		for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; ++i)
+		{
+			if (memoryTypeBits & (1u << i))
+			{
+				return i;
+			}
+		}
+		return 0;
+	}
+
+	// Ԏg\[X̃蓖Ă. linear ̓obt@Ɛ`^CÕC[WȂ true.
+	// sꍇ IsValid()  false  GpuAllocation Ԃ.
+	GpuAllocation Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, bool linear)
+	{
+		auto memoryType = FindMemoryType(requirements.memoryTypeBits, properties);
+		// obt@ƍœK^CÕC[WאڂȂ悤AubN𕪂.
+		auto poolKey = memoryType * 2 + (linear ? 1 : 0);
+		auto reserved = std::max({ std::bit_ceil(requirements.size), requirements.alignment, MinAllocationSize });
+		if (!linear)
+		{
+			reserved = std::max(reserved, m_bufferImageGranularity);
+		}
+
+		GpuAllocation allocation{ .size = requirements.size, .poolKey = poolKey };
+		auto blockSize = GetBlockSize(memoryType);
+		if (reserved > blockSize / 2)
+		{
+			// 傫ȃ\[X̓ubNLĂ܂̂ŐpɊmۂ.
+			allocation.memory = AllocateMemory(requirements.size, memoryType, &allocation.mapped);
+			allocation.reservedSize = requirements.size;
+			if (allocation.IsValid())
+			{
+				++m_stats.dedicatedCount;
+				AddUsage(allocation);
+			}
+			return allocation;
+		}
+
+		auto& pool = m_pools[poolKey];
+		for (uint32_t i = 0; i <= uint32_t(pool.blocks.size()); ++i)
+		{
+			if (i == pool.blocks.size())
+			{
+				auto block = std::make_unique<Block>(blockSize);
+				block->memory = AllocateMemory(blockSize, memoryType, &block->mapped);
+				if (block->memory == VK_NULL_HANDLE)
+				{
+					return allocation;
+				}
+				++m_stats.blockCount;
+				m_stats.blockBytes += blockSize;
+				pool.blocks.push_back(std::move(block));
+			}
+			auto& block = *pool.blocks[i];
+			VkDeviceSize offset;
+			if (block.Allocate(reserved, &offset))
+			{
+				allocation.memory = block.memory;
+				allocation.offset = offset;
+				allocation.mapped = block.mapped ? static_cast<uint8_t*>(block.mapped) + offset : nullptr;
+				allocation.blockIndex = i;
+				allocation.reservedSize = reserved;
+				AddUsage(allocation);
+				return allocation;
+			}
+		}
+		return allocation;
+	}
+
+	// serial ̃t[ŎgI. allocation ͋ɂȂ.
+	void Free(GpuAllocation& allocation, uint64_t serial)
+	{
+		if (!allocation.IsValid())
+		{
+			return;
+		}
+		m_pendingFrees.push_back(PendingFree{ .serial = serial, .allocation = allocation });
+		allocation = {};
+	}
+
+	// completedSerial ܂ł̃t[̂ŁA܂łɉꂽėpł悤ɂ.
+	// p VkDeviceMemory ͂ŉA̎_ maxMemoryAllocationCount ̘g߂.
+	void Flush(uint64_t completedSerial)
+	{
+		while (!m_pendingFrees.empty() && m_pendingFrees.front().serial <= completedSerial)
+		{
+			auto& allocation = m_pendingFrees.front().allocation;
+			if (allocation.blockIndex == UINT32_MAX)
+			{
+				m_deletionQueue->DestroyNow(allocation.memory);
+				--m_memoryAllocationCount;
+				--m_stats.dedicatedCount;
+			}
+			else
+			{
+				m_pools[allocation.poolKey].blocks[allocation.blockIndex]->Free(allocation.offset, allocation.reservedSize);
+			}
+			RemoveUsage(allocation);
+			m_pendingFrees.pop_front();
+		}
+	}
+
+	const Stats& GetStats() const { return m_stats; }
+
+	std::string FormatStats() const
+	{
+		return std::format("GPU memory: {} blocks ({} KiB), {} allocations ({} dedicated), {} KiB used, {} KiB wasted.\n",
+			m_stats.blockCount, m_stats.blockBytes >> 10, m_stats.allocationCount, m_stats.dedicatedCount,
+			m_stats.usedBytes >> 10, m_stats.wastedBytes >> 10);
+	}
+
+private:
+	static constexpr VkDeviceSize MinAllocationSize = 256;
+	static constexpr VkDeviceSize DefaultBlockSize = 64ull << 20;
+
+	// 2 ׂ̂̃TCYŕEofBAP[^.
+	struct Block
+	{
+		explicit Block(VkDeviceSize size)
+			: size(size)
+		{
+			freeLists.resize(std::countr_zero(size / MinAllocationSize) + 1);
+			freeLists.back().insert(0);
+		}
+
+		bool Allocate(VkDeviceSize reserved, VkDeviceSize* offset)
+		{
+			auto order = uint32_t(std::countr_zero(reserved / MinAllocationSize));
+			auto found = order;
+			while (found < freeLists.size() && freeLists[found].empty())
+			{
+				++found;
+			}
+			if (found >= freeLists.size())
+			{
+				return false;
+			}
+			auto start = *freeLists[found].begin();
+			freeLists[found].erase(freeLists[found].begin());
+			// ]㔼1iXgɖ߂.
+			while (found > order)
+			{
+				--found;
+				freeLists[found].insert(start + (MinAllocationSize << found));
+			}
+			*offset = start;
+			return true;
+		}
+
+		void Free(VkDeviceSize offset, VkDeviceSize reserved)
+		{
+			auto order = uint32_t(std::countr_zero(reserved / MinAllocationSize));
+			// 󂢂ĂΌď̒iɖ߂.
+			while (order + 1 < freeLists.size())
+			{
+				auto buddy = offset ^ (MinAllocationSize << order);
+				auto it = freeLists[order].find(buddy);
+				if (it == freeLists[order].end())
+				{
+					break;
+				}
+				freeLists[order].erase(it);
+				offset = std::min(offset, buddy);
+				++order;
+			}
+			freeLists[order].insert(offset);
+		}
+
+		VkDeviceSize size;
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		void* mapped = nullptr;
+		std::vector<std::set<VkDeviceSize>> freeLists;
+	};
+
+	struct Pool
+	{
+		std::vector<std::unique_ptr<Block>> blocks;
+	};
+
+	struct PendingFree
+	{
+		uint64_t serial;
+		GpuAllocation allocation;
+	};
+
+	// q[vꍇ̓ubN.
+	VkDeviceSize GetBlockSize(uint32_t memoryType) const
+	{
+		auto heapSize = m_memoryProperties.memoryHeaps[m_memoryProperties.memoryTypes[memoryType].heapIndex].size;
+		return std::clamp(std::bit_floor(heapSize / 8), MinAllocationSize, DefaultBlockSize);
+	}
+
+	VkDeviceMemory AllocateMemory(VkDeviceSize size, uint32_t memoryType, void** mapped)
+	{
+		*mapped = nullptr;
+		if (m_memoryAllocationCount >= m_maxAllocationCount)
+		{
+			return VK_NULL_HANDLE;
+		}
+		VkMemoryAllocateInfo allocateInfo{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+			.allocationSize = size,
+			.memoryTypeIndex = memoryType,
+		};
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		if (vkAllocateMemory(m_device, &allocateInfo, nullptr, &memory) != VK_SUCCESS)
+		{
+			return VK_NULL_HANDLE;
+		}
+		m_deletionQueue->Track(memory);
+		++m_memoryAllocationCount;
+		if (m_memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+		{
+			vkMapMemory(m_device, memory, 0, VK_WHOLE_SIZE, 0, mapped);
+		}
+		return memory;
+	}
+
+	void AddUsage(const GpuAllocation& allocation)
+	{
+		++m_stats.allocationCount;
+		m_stats.usedBytes += allocation.size;
+		m_stats.wastedBytes += allocation.reservedSize - allocation.size;
+	}
+
+	void RemoveUsage(const GpuAllocation& allocation)
+	{
+		--m_stats.allocationCount;
+		m_stats.usedBytes -= allocation.size;
+		m_stats.wastedBytes -= allocation.reservedSize - allocation.size;
+	}
+
+	VkDevice m_device = VK_NULL_HANDLE;
+	DeletionQueue* m_deletionQueue = nullptr;
+	VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+	uint32_t m_maxAllocationCount = 4096;
+	uint32_t m_memoryAllocationCount = 0;
+	VkDeviceSize m_bufferImageGranularity = 1;
+	std::map<uint32_t, Pool> m_pools;
+	std::deque<PendingFree> m_pendingFrees;
+	Stats m_stats;
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Œ萔̃[J[XbhŃWuɎs.
+// Dispatch() ͌ĂяoXbhubNAׂẴWů҂Ă߂.
+class JobSystem
+{
+public:
+	// jobIndex  0  jobCount-1AworkerIndex ͎sĂ郏[J[̔ԍ.
+	using JobFunc = std::function<void(uint32_t jobIndex, uint32_t workerIndex)>;
+
+	void Initialize(uint32_t workerCount)
+	{
+		for (uint32_t i = 0; i < workerCount; ++i)
+		{
+			m_threads.emplace_back([this, i]() { WorkerMain(i); });
+		}
+	}
+
+	void Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_quit = true;
+		}
+		m_wakeCv.notify_all();
+		for (auto& thread : m_threads)
+		{
+			thread.join();
+		}
+		m_threads.clear();
+		m_quit = false;
+	}
+
+	uint32_t GetWorkerCount() const
+	{
+		return uint32_t(m_threads.size());
+	}
+
+	void Dispatch(uint32_t jobCount, const JobFunc& func)
+	{
+		if (jobCount == 0 || m_threads.empty())
+		{
+			return;
+		}
+		std::unique_lock<std::mutex> lock(m_mutex);
+		// ÕWuɍs[J[܂Ŏn߂Ȃ.
+		m_doneCv.wait(lock, [&]() { return m_activeWorkers == 0; });
+		m_func = &func;
+		m_jobCount = jobCount;
+		m_remainingJobs = jobCount;
+		m_nextJob.store(0, std::memory_order_relaxed);
+		++m_generation;
+		lock.unlock();
+		m_wakeCv.notify_all();
+
+		lock.lock();
+		m_doneCv.wait(lock, [&]() { return m_remainingJobs == 0 && m_activeWorkers == 0; });
+		m_func = nullptr;
+	}
+
+private:
+	void WorkerMain(uint32_t workerIndex)
+	{
+		uint64_t generation = 0;
+		for (;;)
+		{
+			const JobFunc* func = nullptr;
+			uint32_t jobCount = 0;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wakeCv.wait(lock, [&]() { return m_quit || m_generation != generation; });
+				if (m_quit)
+				{
+					return;
+				}
+				generation = m_generation;
+				func = m_func;
+				jobCount = m_jobCount;
+				++m_activeWorkers;
+			}
+
+			uint32_t executed = 0;
+			for (uint32_t job = m_nextJob.fetch_add(1); job < jobCount; job = m_nextJob.fetch_add(1))
+			{
+				(*func)(job, workerIndex);
+				++executed;
+			}
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_remainingJobs -= executed;
+			--m_activeWorkers;
+			if (m_remainingJobs == 0 && m_activeWorkers == 0)
+			{
+				m_doneCv.notify_all();
+			}
+		}
+	}
+
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_wakeCv;
+	std::condition_variable m_doneCv;
+	const JobFunc* m_func = nullptr;
+	uint32_t m_jobCount = 0;
+	uint32_t m_remainingJobs = 0;
+	uint32_t m_activeWorkers = 0;
+	uint64_t m_generation = 0;
+	bool m_quit = false;
+	std::atomic<uint32_t> m_nextJob{ 0 };
+};
@@ -0,0 +1,459 @@
+#pragma once
+
+#include "Volk/volk.h"
+#include "AsyncQueue.h"
+#include "DeletionQueue.h"
+#include "GpuAllocator.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "cullShader.h"
+
+// ʂ̃IuWFNg GPU 쓮ŕ`悷.
+// IuWFNg͎̑ނƂ̔z (SoA) ŃfoCX[J̃obt@ɒuA
+// t[ARs[gVF[_[Ŏ̊ÕIuWFNg VkDrawIndexedIndirectCommand ̔z.
+// ` vkCmdDrawIndexedIndirectCount  1 ōςނ̂ŁACPU ׂ̓̕IuWFNgɈˑȂ.
+// `R}h̔z̓t[̃XbgƂɎAJO񓯊Rs[gL[őÕt[̕`Əd˂悤ɂ.
+class ObjectRenderer
+{
+public:
+	// \͈. center 𒆐SɁA1/scale ͈̔͂ʂɎ܂.
+	struct View
+	{
+		float center[2];
+		float scale[2];
+	};
+
+	// IuWFNgzu͈ (-WorldExtent  WorldExtent).
+	static constexpr float WorldExtent = 8.0f;
+
+	// queueFamilies ̓obt@gL[t@~[ (]AJOA`). frameCount ̓t[̃Xbg.
+	bool Initialize(VkDevice device, GpuAllocator& allocator, DeletionQueue& deletionQueue, VkPipelineCache pipelineCache,
+		uint32_t objectCount, uint32_t frameCount, std::span<const uint32_t> queueFamilies,
+		PFN_vkCmdDrawIndexedIndirectCount drawIndexedIndirectCount)
+	{
+		m_device = device;
+		m_allocator = &allocator;
+		m_deletionQueue = &deletionQueue;
+		m_objectCount = objectCount;
+		m_drawIndexedIndirectCount = drawIndexedIndirectCount;
+		for (auto family : queueFamilies)
+		{
+			if (std::find(m_queueFamilies.begin(), m_queueFamilies.end(), family) == m_queueFamilies.end())
+			{
+				m_queueFamilies.push_back(family);
+			}
+		}
+
+		// eIuWFNg̈ʒuƔa (xy, w)AF SoA ŗpӂ.
+		std::vector<float> bounds(size_t(objectCount) * 4);
+		std::vector<float> colors(size_t(objectCount) * 4);
+		std::mt19937 random(12345);
+		std::uniform_real_distribution<float> position(-WorldExtent, WorldExtent);
+		std::uniform_real_distribution<float> radius(0.01f, 0.04f);
+		std::uniform_real_distribution<float> color(0.2f, 1.0f);
+		for (uint32_t i = 0; i < objectCount; ++i)
+		{
+			bounds[i * 4 + 0] = position(random);
+			bounds[i * 4 + 1] = position(random);
+			bounds[i * 4 + 2] = 0.0f;
+			bounds[i * 4 + 3] = radius(random);
+			colors[i * 4 + 0] = color(random);
+			colors[i * 4 + 1] = color(random);
+			colors[i * 4 + 2] = color(random);
+			colors[i * 4 + 3] = 1.0f;
+		}
+		const std::array<uint16_t, 4> indices{ 0, 1, 2, 0 };
+
+		// ʒuƔa̓JOƕ`̗̃L[œǂނ̂ŁÃt@~[ŋL.
+		// ȊO 1 ̃L[ĝŁAL̈ړŎ󂯓n.
+		auto storage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+		m_bounds = CreateBuffer(bounds.size() * sizeof(float), storage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true);
+		m_colors = CreateBuffer(colors.size() * sizeof(float), storage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		m_indices = CreateBuffer(sizeof(indices), VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		bool valid = m_bounds.allocation.IsValid() && m_colors.allocation.IsValid() && m_indices.allocation.IsValid();
+		m_slots.resize(frameCount);
+		for (auto& slot : m_slots)
+		{
+			slot.commands = CreateBuffer(VkDeviceSize(objectCount) * sizeof(VkDrawIndexedIndirectCommand),
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			slot.count = CreateBuffer(sizeof(uint32_t),
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			valid = valid && slot.commands.allocation.IsValid() && slot.count.allocation.IsValid();
+		}
+
+		// f[^̓Xe[WOobt@ɏARecordUpload() ŃRs[.
+		m_staging = CreateBuffer(m_bounds.size + m_colors.size + m_indices.size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+		if (!valid || m_staging.allocation.mapped == nullptr)
+		{
+			return false;
+		}
+		auto* staging = static_cast<uint8_t*>(m_staging.allocation.mapped);
+		std::memcpy(staging, bounds.data(), m_bounds.size);
+		std::memcpy(staging + m_bounds.size, colors.data(), m_colors.size);
+		std::memcpy(staging + m_bounds.size + m_colors.size, indices.data(), m_indices.size);
+
+		InitializeDescriptors();
+		InitializeCullPipeline(pipelineCache);
+		return true;
+	}
+
+	void Shutdown(uint64_t serial)
+	{
+		m_deletionQueue->Destroy(m_cullPipeline, serial);
+		m_deletionQueue->Destroy(m_pipelineLayout, serial);
+		m_deletionQueue->Destroy(m_descriptorPool, serial);
+		m_deletionQueue->Destroy(m_descriptorSetLayout, serial);
+		for (auto* buffer : { &m_bounds, &m_colors, &m_indices, &m_staging })
+		{
+			DestroyBuffer(*buffer, serial);
+		}
+		for (auto& slot : m_slots)
+		{
+			DestroyBuffer(slot.commands, serial);
+			DestroyBuffer(slot.count, serial);
+		}
+		m_slots.clear();
+	}
+
+	uint32_t GetObjectCount() const { return m_objectCount; }
+	// `p̃pCvC͂̃CAEgŌĂяo쐬.
+	VkPipelineLayout GetPipelineLayout() const { return m_pipelineLayout; }
+
+	// f[^̃Rs[. transfer.srcFamily ̃L[ŎsAL transfer.dstFamily ɓn.
+	void RecordUpload(VkCommandBuffer commandBuffer, const QueueOwnershipTransfer& transfer) const
+	{
+		VkDeviceSize offset = 0;
+		for (auto* buffer : { &m_bounds, &m_colors, &m_indices })
+		{
+			VkBufferCopy region{
+				.srcOffset = offset,
+				.dstOffset = 0,
+				.size = buffer->size,
+			};
+			vkCmdCopyBuffer(commandBuffer, m_staging.buffer, buffer->buffer, 1, &region);
+			if (!buffer->concurrent)
+			{
+				transfer.ReleaseBuffer(commandBuffer, buffer->buffer, 0, VK_WHOLE_SIZE,
+					VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+			}
+			offset += buffer->size;
+		}
+	}
+
+	// RecordUpload() ̌ʂg悤ɂ. transfer.dstFamily ̃L[Ŏs.
+	void RecordAcquire(VkCommandBuffer commandBuffer, const QueueOwnershipTransfer& transfer) const
+	{
+		auto dstStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		auto dstAccess = VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+		if (!transfer.IsNeeded())
+		{
+			// L[ŃRs[ꍇ͒ʏ̃oAő.
+			VkMemoryBarrier barrier{
+				.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+				.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+				.dstAccessMask = VkAccessFlags(dstAccess),
+			};
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+			return;
+		}
+		// LĂobt@̓Z}tH̑҂킹œǂ߂.
+		for (auto* buffer : { &m_colors, &m_indices })
+		{
+			transfer.AcquireBuffer(commandBuffer, buffer->buffer, 0, VK_WHOLE_SIZE, dstStage, dstAccess);
+		}
+	}
+
+	// serial ̃t[ŃAbv[ĥŁǍŃXe[WOobt@.
+	void ReleaseStaging(uint64_t serial)
+	{
+		DestroyBuffer(m_staging, serial);
+	}
+
+	// _[pX̊OŋL^. Xbg slot ̕`R}h̔zƌ蒼.
+	// transfer.srcFamily ̃L[ŎsAʂ̏L transfer.dstFamily ɓn.
+	// O̓e͎gȂ̂ŁAO`悵L[珊L߂Kv͂Ȃ.
+	void RecordCull(VkCommandBuffer commandBuffer, uint32_t slot, const View& view, const QueueOwnershipTransfer& transfer)
+	{
+		auto& target = m_slots[slot];
+		// ̃XbgOɎgt[̊Ԑڕ`Ə݂IĂ蒼.
+		VkMemoryBarrier reuseBarrier{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+			.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+		};
+		vkCmdPipelineBarrier(commandBuffer,
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			0, 1, &reuseBarrier, 0, nullptr, 0, nullptr);
+		vkCmdFillBuffer(commandBuffer, target.count.buffer, 0, sizeof(uint32_t), 0);
+
+		VkMemoryBarrier clearBarrier{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+			.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+		};
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			0, 1, &clearBarrier, 0, nullptr, 0, nullptr);
+
+		auto params = MakeParams(view);
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_cullPipeline);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &target.descriptorSet, 0, nullptr);
+		vkCmdPushConstants(commandBuffer, m_pipelineLayout, PushConstantStages, 0, sizeof(params), &params);
+		vkCmdDispatch(commandBuffer, (m_objectCount + CullGroupSize - 1) / CullGroupSize, 1, 1);
+
+		if (transfer.IsNeeded())
+		{
+			for (auto* buffer : { &target.commands, &target.count })
+			{
+				transfer.ReleaseBuffer(commandBuffer, buffer->buffer, 0, VK_WHOLE_SIZE,
+					VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+			}
+			return;
+		}
+		VkMemoryBarrier drawBarrier{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+			.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+		};
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+			0, 1, &drawBarrier, 0, nullptr, 0, nullptr);
+	}
+
+	// ʂ̃L[ RecordCull() ʂ󂯎. _[pX̊OŁA`悷L[ŋL^.
+	void RecordAcquireCommands(VkCommandBuffer commandBuffer, uint32_t slot, const QueueOwnershipTransfer& transfer) const
+	{
+		if (!transfer.IsNeeded())
+		{
+			return;
+		}
+		auto& target = m_slots[slot];
+		for (auto* buffer : { &target.commands, &target.count })
+		{
+			transfer.AcquireBuffer(commandBuffer, buffer->buffer, 0, VK_WHOLE_SIZE,
+				VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+		}
+	}
+
+	// _[pX̒ŋL^. r[|[gƃVU[͌ĂяoŐݒ肵Ă.
+	void RecordDraw(VkCommandBuffer commandBuffer, uint32_t slot, VkPipeline pipeline, const View& view) const
+	{
+		auto& target = m_slots[slot];
+		auto params = MakeParams(view);
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, &target.descriptorSet, 0, nullptr);
+		vkCmdPushConstants(commandBuffer, m_pipelineLayout, PushConstantStages, 0, sizeof(params), &params);
+		vkCmdBindIndexBuffer(commandBuffer, m_indices.buffer, 0, VK_INDEX_TYPE_UINT16);
+		m_drawIndexedIndirectCount(commandBuffer, target.commands.buffer, 0, target.count.buffer, 0,
+			m_objectCount, sizeof(VkDrawIndexedIndirectCommand));
+	}
+
+private:
+	static constexpr uint32_t CullGroupSize = 64;
+	static constexpr VkShaderStageFlags PushConstantStages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+
+	// instance.vert  cull.comp  push_constant ubN.
+	struct Params
+	{
+		float view[4];
+		// ̍E㉺̕ (xy: @, w: ).
+		float planes[4][4];
+		uint32_t objectCount;
+	};
+
+	struct Buffer
+	{
+		VkBuffer buffer = VK_NULL_HANDLE;
+		VkDeviceSize size = 0;
+		GpuAllocation allocation;
+		// VK_SHARING_MODE_CONCURRENT ō. L̈ړ͕sv.
+		bool concurrent = false;
+	};
+
+	// t[̃XbgƂ̃JǑ.
+	struct Slot
+	{
+		Buffer commands;
+		Buffer count;
+		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+	};
+
+	Params MakeParams(const View& view) const
+	{
+		float halfWidth = 1.0f / view.scale[0];
+		float halfHeight = 1.0f / view.scale[1];
+		return Params{
+			.view = { view.center[0], view.center[1], view.scale[0], view.scale[1] },
+			.planes = {
+				{ 1.0f, 0.0f, 0.0f, halfWidth - view.center[0] },
+				{ -1.0f, 0.0f, 0.0f, halfWidth + view.center[0] },
+				{ 0.0f, 1.0f, 0.0f, halfHeight - view.center[1] },
+				{ 0.0f, -1.0f, 0.0f, halfHeight + view.center[1] },
+			},
+			.objectCount = m_objectCount,
+		};
+	}
+
+	// shared ȂAgL[t@~[ꍇ VK_SHARING_MODE_CONCURRENT ō.
+	Buffer CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, bool shared = false)
+	{
+		Buffer buffer{ .size = size, .concurrent = shared && m_queueFamilies.size() > 1 };
+		VkBufferCreateInfo bufferCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+			.size = size,
+			.usage = usage,
+			.sharingMode = buffer.concurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+			.queueFamilyIndexCount = buffer.concurrent ? uint32_t(m_queueFamilies.size()) : 0,
+			.pQueueFamilyIndices = buffer.concurrent ? m_queueFamilies.data() : nullptr,
+		};
+		vkCreateBuffer(m_device, &bufferCreateInfo, nullptr, &buffer.buffer);
+		m_deletionQueue->Track(buffer.buffer);
+
+		VkMemoryRequirements memoryRequirements;
+		vkGetBufferMemoryRequirements(m_device, buffer.buffer, &memoryRequirements);
+		buffer.allocation = m_allocator->Allocate(memoryRequirements, properties, true);
+		if (buffer.allocation.IsValid())
+		{
+			vkBindBufferMemory(m_device, buffer.buffer, buffer.allocation.memory, buffer.allocation.offset);
+		}
+		return buffer;
+	}
+
+	void DestroyBuffer(Buffer& buffer, uint64_t serial)
+	{
+		m_deletionQueue->Destroy(buffer.buffer, serial);
+		m_allocator->Free(buffer.allocation, serial);
+	}
+
+	void InitializeDescriptors()
+	{
+		// 0: ʒuƔa, 1: F, 2: `R}h, 3: `R}ȟ.
+		std::array<VkDescriptorSetLayoutBinding, 4> bindings{};
+		for (uint32_t i = 0; i < uint32_t(bindings.size()); ++i)
+		{
+			bindings[i] = VkDescriptorSetLayoutBinding{
+				.binding = i,
+				.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+				.descriptorCount = 1,
+				.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT,
+			};
+		}
+		VkDescriptorSetLayoutCreateInfo layoutCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+			.bindingCount = uint32_t(bindings.size()),
+			.pBindings = bindings.data(),
+		};
+		vkCreateDescriptorSetLayout(m_device, &layoutCreateInfo, nullptr, &m_descriptorSetLayout);
+		m_deletionQueue->Track(m_descriptorSetLayout);
+
+		// XbgƂɁÃXbg̕`R}hwZbg.
+		auto setCount = uint32_t(m_slots.size());
+		VkDescriptorPoolSize poolSize{
+			.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			.descriptorCount = uint32_t(bindings.size()) * setCount,
+		};
+		VkDescriptorPoolCreateInfo poolCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+			.maxSets = setCount,
+			.poolSizeCount = 1,
+			.pPoolSizes = &poolSize,
+		};
+		vkCreateDescriptorPool(m_device, &poolCreateInfo, nullptr, &m_descriptorPool);
+		m_deletionQueue->Track(m_descriptorPool);
+
+		for (auto& slot : m_slots)
+		{
+			VkDescriptorSetAllocateInfo allocateInfo{
+				.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+				.descriptorPool = m_descriptorPool,
+				.descriptorSetCount = 1,
+				.pSetLayouts = &m_descriptorSetLayout,
+			};
+			vkAllocateDescriptorSets(m_device, &allocateInfo, &slot.descriptorSet);
+
+			std::array<VkDescriptorBufferInfo, 4> bufferInfos{{
+				{ .buffer = m_bounds.buffer, .offset = 0, .range = VK_WHOLE_SIZE },
+				{ .buffer = m_colors.buffer, .offset = 0, .range = VK_WHOLE_SIZE },
+				{ .buffer = slot.commands.buffer, .offset = 0, .range = VK_WHOLE_SIZE },
+				{ .buffer = slot.count.buffer, .offset = 0, .range = VK_WHOLE_SIZE },
+			}};
+			std::array<VkWriteDescriptorSet, 4> writes{};
+			for (uint32_t i = 0; i < uint32_t(writes.size()); ++i)
+			{
+				writes[i] = VkWriteDescriptorSet{
+					.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+					.dstSet = slot.descriptorSet,
+					.dstBinding = i,
+					.descriptorCount = 1,
+					.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+					.pBufferInfo = &bufferInfos[i],
+				};
+			}
+			vkUpdateDescriptorSets(m_device, uint32_t(writes.size()), writes.data(), 0, nullptr);
+		}
+
+		VkPushConstantRange pushConstantRange{
+			.stageFlags = PushConstantStages,
+			.offset = 0,
+			.size = sizeof(Params),
+		};
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+			.setLayoutCount = 1,
+			.pSetLayouts = &m_descriptorSetLayout,
+			.pushConstantRangeCount = 1,
+			.pPushConstantRanges = &pushConstantRange,
+		};
+		vkCreatePipelineLayout(m_device, &pipelineLayoutCreateInfo, nullptr, &m_pipelineLayout);
+		m_deletionQueue->Track(m_pipelineLayout);
+	}
+
+	void InitializeCullPipeline(VkPipelineCache pipelineCache)
+	{
+		VkShaderModuleCreateInfo moduleCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+			.codeSize = sizeof(gCullCS),
+			.pCode = gCullCS,
+		};
+		VkShaderModule module = VK_NULL_HANDLE;
+		vkCreateShaderModule(m_device, &moduleCreateInfo, nullptr, &module);
+		m_deletionQueue->Track(module);
+
+		VkComputePipelineCreateInfo pipelineCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+			.stage = {
+				.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+				.stage = VK_SHADER_STAGE_COMPUTE_BIT,
+				.module = module,
+				.pName = "main",
+			},
+			.layout = m_pipelineLayout,
+		};
+		vkCreateComputePipelines(m_device, pipelineCache, 1, &pipelineCreateInfo, nullptr, &m_cullPipeline);
+		m_deletionQueue->Track(m_cullPipeline);
+		m_deletionQueue->Destroy(module, 0);
+	}
+
+	VkDevice m_device = VK_NULL_HANDLE;
+	GpuAllocator* m_allocator = nullptr;
+	DeletionQueue* m_deletionQueue = nullptr;
+	PFN_vkCmdDrawIndexedIndirectCount m_drawIndexedIndirectCount = nullptr;
+	uint32_t m_objectCount = 0;
+	std::vector<uint32_t> m_queueFamilies;
+	Buffer m_bounds;
+	Buffer m_colors;
+	Buffer m_indices;
+	Buffer m_staging;
+	std::vector<Slot> m_slots;
+	VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE;
+	VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+	VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+	VkPipeline m_cullPipeline = VK_NULL_HANDLE;
+};
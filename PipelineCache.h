@@ -0,0 +1,257 @@
+#pragma once
+
+#include "Volk/volk.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// fBXNɕۑ VkPipelineCache.
+// hCoof[^̑OɓƎ̃wb_tAʂ GPU hCoōꂽf[^͓ǂݎ̂Ă.
+class PipelineCache
+{
+public:
+	// t@CǂݍŃpCvCLbV쐬.
+	// t@CA܂͌؂Ɏsꍇ͋̃LbVŎn߂.
+	bool Initialize(VkDevice device, VkPhysicalDevice gpu, const std::string& path)
+	{
+		m_device = device;
+		m_path = path;
+		vkGetPhysicalDeviceProperties(gpu, &m_properties);
+
+		std::vector<uint8_t> data;
+		if (!m_path.empty())
+		{
+			data = Load();
+		}
+		else
+		{
+			m_status = "disabled";
+		}
+
+		VkPipelineCacheCreateInfo createInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+			.initialDataSize = data.size(),
+			.pInitialData = data.empty() ? nullptr : data.data(),
+		};
+		if (vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache) != VK_SUCCESS && !data.empty())
+		{
+			// ؂ʂĂhCoɋۂ邱Ƃ̂ŁÃLbVō蒼.
+			m_status = "rejected by driver";
+			data.clear();
+			createInfo.initialDataSize = 0;
+			createInfo.pInitialData = nullptr;
+			vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache);
+		}
+		m_loadedSize = data.size();
+		m_loadedChecksum = Checksum(data);
+		return m_cache != VK_NULL_HANDLE;
+	}
+
+	// LbV̓eɕω΃t@Cɏ߂Ăj.
+	void Shutdown()
+	{
+		if (m_cache == VK_NULL_HANDLE)
+		{
+			return;
+		}
+		if (!m_path.empty())
+		{
+			Save();
+		}
+		vkDestroyPipelineCache(m_device, m_cache, nullptr);
+		m_cache = VK_NULL_HANDLE;
+	}
+
+	VkPipelineCache GetHandle() const { return m_cache; }
+	// Lȃf[^ǂݍ߂Ă true (EH[X^[g).
+	bool IsWarm() const { return m_loadedSize > 0; }
+	size_t GetLoadedSize() const { return m_loadedSize; }
+	// ǂݍ݌ʂ̐ (Oo͗p).
+	const std::string& GetStatus() const { return m_status; }
+
+	// ꎞt@CɏĂûŁArŏIĂꂽt@C͎cȂ.
+	bool Save()
+	{
+		size_t size = 0;
+		if (vkGetPipelineCacheData(m_device, m_cache, &size, nullptr) != VK_SUCCESS || size == 0)
+		{
+			return false;
+		}
+		std::vector<uint8_t> data(size);
+		if (vkGetPipelineCacheData(m_device, m_cache, &size, data.data()) != VK_SUCCESS)
+		{
+			return false;
+		}
+		data.resize(size);
+
+		auto checksum = Checksum(data);
+		if (data.size() == m_loadedSize && checksum == m_loadedChecksum)
+		{
+			// ǂݍ񂾓eωĂȂ.
+			return true;
+		}
+
+		FileHeader header = MakeHeader();
+		header.dataSize = data.size();
+		header.checksum = checksum;
+
+		auto tempPath = m_path + ".tmp";
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+			if (!file)
+			{
+				return false;
+			}
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+			if (!file)
+			{
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(tempPath, m_path, ec);
+		if (ec)
+		{
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+		m_loadedSize = data.size();
+		m_loadedChecksum = checksum;
+		return true;
+	}
+
+private:
+	static constexpr uint32_t FileMagic = 0x43505646; // "FVPC"
+	static constexpr uint32_t FileVersion = 1;
+
+	// t@C擪ɒuwb_. Vulkan ̃LbVwb_ɂ͖hCõo[Wr.
+	struct FileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t vendorID;
+		uint32_t deviceID;
+		uint32_t driverVersion;
+		uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+		uint64_t dataSize;
+		uint64_t checksum;
+	};
+
+	FileHeader MakeHeader() const
+	{
+		FileHeader header{
+			.magic = FileMagic,
+			.version = FileVersion,
+			.vendorID = m_properties.vendorID,
+			.deviceID = m_properties.deviceID,
+			.driverVersion = m_properties.driverVersion,
+		};
+		std::memcpy(header.pipelineCacheUUID, m_properties.pipelineCacheUUID, VK_UUID_SIZE);
+		return header;
+	}
+
+	std::vector<uint8_t> Load()
+	{
+		std::ifstream file(m_path, std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			m_status = "not found";
+			return {};
+		}
+		auto fileSize = size_t(file.tellg());
+		file.seekg(0);
+
+		FileHeader header{};
+		if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		{
+			m_status = "truncated header";
+			return {};
+		}
+
+		auto expected = MakeHeader();
+		if (header.magic != expected.magic || header.version != expected.version)
+		{
+			m_status = "unknown format";
+			return {};
+		}
+		if (header.vendorID != expected.vendorID || header.deviceID != expected.deviceID)
+		{
+			m_status = "different device";
+			return {};
+		}
+		if (header.driverVersion != expected.driverVersion)
+		{
+			m_status = "different driver version";
+			return {};
+		}
+		if (std::memcmp(header.pipelineCacheUUID, expected.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+		{
+			m_status = "different pipeline cache UUID";
+			return {};
+		}
+		if (header.dataSize != fileSize - sizeof(header))
+		{
+			m_status = "size mismatch";
+			return {};
+		}
+
+		std::vector<uint8_t> data(size_t(header.dataSize));
+		if (!file.read(reinterpret_cast<char*>(data.data()), std::streamsize(data.size())))
+		{
+			m_status = "read error";
+			return {};
+		}
+		if (Checksum(data) != header.checksum)
+		{
+			m_status = "checksum mismatch";
+			return {};
+		}
+
+		// hCoowb_ÔߊmF.
+		VkPipelineCacheHeaderVersionOne cacheHeader{};
+		if (data.size() < sizeof(cacheHeader))
+		{
+			m_status = "truncated cache data";
+			return {};
+		}
+		std::memcpy(&cacheHeader, data.data(), sizeof(cacheHeader));
+		if (cacheHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+			cacheHeader.vendorID != m_properties.vendorID ||
+			cacheHeader.deviceID != m_properties.deviceID ||
+			std::memcmp(cacheHeader.pipelineCacheUUID, m_properties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+		{
+			m_status = "cache header mismatch";
+			return {};
+		}
+
+		m_status = std::format("loaded {} bytes", data.size());
+		return data;
+	}
+
+	// FNV-1a (64bit).
+	static uint64_t Checksum(const std::vector<uint8_t>& data)
+	{
+		uint64_t hash = 0xcbf29ce484222325ull;
+		for (auto b : data)
+		{
+			hash ^= b;
+			hash *= 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	VkDevice m_device = VK_NULL_HANDLE;
+	VkPipelineCache m_cache = VK_NULL_HANDLE;
+	VkPhysicalDeviceProperties m_properties{};
+	std::string m_path;
+	std::string m_status;
+	size_t m_loadedSize = 0;
+	uint64_t m_loadedChecksum = 0;
+};
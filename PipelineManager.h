@@ -0,0 +1,413 @@
+#pragma once
+
+#include "Volk/volk.h"
+#include "DeletionQueue.h"
+#include "FrameProfiler.h"
+#include "ShaderLibrary.h"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <format>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// OtBbNXpCvC̍쐬ɕKvȏ. Ԃ̃pCvC 1 .
+struct GraphicsPipelineState
+{
+	std::string vertexShader;
+	std::string fragmentShader;
+	VkPipelineLayout layout = VK_NULL_HANDLE;
+	// VK_NULL_HANDLE Ȃ瓮I_Op colorFormat ō.
+	VkRenderPass renderPass = VK_NULL_HANDLE;
+	VkFormat colorFormat = VK_FORMAT_UNDEFINED;
+	VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+	VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+	VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+	VkFrontFace frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+	VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+	bool blendEnable = false;
+
+	bool operator==(const GraphicsPipelineState&) const = default;
+
+	uint64_t Hash() const
+	{
+		uint64_t hash = 0xcbf29ce484222325ull;
+		auto mix = [&](const void* data, size_t size) {
+			for (size_t i = 0; i < size; ++i)
+			{
+				hash ^= static_cast<const uint8_t*>(data)[i];
+				hash *= 0x100000001b3ull;
+			}
+		};
+		mix(vertexShader.data(), vertexShader.size() + 1);
+		mix(fragmentShader.data(), fragmentShader.size() + 1);
+		mix(&layout, sizeof(layout));
+		mix(&renderPass, sizeof(renderPass));
+		mix(&colorFormat, sizeof(colorFormat));
+		mix(&topology, sizeof(topology));
+		mix(&polygonMode, sizeof(polygonMode));
+		mix(&cullMode, sizeof(cullMode));
+		mix(&frontFace, sizeof(frontFace));
+		mix(&samples, sizeof(samples));
+		mix(&blendEnable, sizeof(blendEnable));
+		return hash;
+	}
+
+	bool UsesShader(const std::string& name) const
+	{
+		return vertexShader == name || fragmentShader == name;
+	}
+};
+
+// pCvC̃oAgԂ̃nbVŊǗA[J[Xbhō쐬.
+// Get() ͂܂쐬ĂȂ΍쐬˗āAɎg̃pCvC ( VK_NULL_HANDLE) Ԃ.
+// [J[쐬pCvĆACXbh Update() Ă񂾂ƂɎg悤ɂȂ.
+class PipelineManager
+{
+public:
+	void Initialize(VkDevice device, ShaderLibrary& shaderLibrary, VkPipelineCache pipelineCache, DeletionQueue& deletionQueue,
+		uint32_t workerCount)
+	{
+		m_device = device;
+		m_shaderLibrary = &shaderLibrary;
+		m_pipelineCache = pipelineCache;
+		m_deletionQueue = &deletionQueue;
+		m_quit = false;
+		for (uint32_t i = 0; i < std::max(workerCount, 1u); ++i)
+		{
+			m_threads.emplace_back([this]() { WorkerMain(); });
+		}
+	}
+
+	// serial ͍Ōɓt[̔ԍ.
+	void Shutdown(uint64_t serial)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_quit = true;
+			m_queue.clear();
+		}
+		m_wakeCv.notify_all();
+		for (auto& thread : m_threads)
+		{
+			thread.join();
+		}
+		m_threads.clear();
+
+		Update(serial);
+		for (auto& [state, entry] : m_entries)
+		{
+			m_deletionQueue->Destroy(entry.pipeline, serial);
+		}
+		m_entries.clear();
+	}
+
+	// CXbhĂ. fallback w肷ƁAstate ̍쐬I܂ fallback ̃pCvCԂ.
+	VkPipeline Get(const GraphicsPipelineState& state, const GraphicsPipelineState* fallback = nullptr)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto& entry = FindOrQueue(state);
+		if (entry.pipeline != VK_NULL_HANDLE)
+		{
+			return entry.pipeline;
+		}
+		++m_fallbackCount;
+		return fallback ? FindOrQueue(*fallback).pipeline : VK_NULL_HANDLE;
+	}
+
+	// 쐬Ɉ˗Ă.
+	void Prefetch(const GraphicsPipelineState& state)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		FindOrQueue(state);
+	}
+
+	// ύXꂽVF[_[gpCvC蒼. ǂ̃XbhłĂׂ.
+	// 蒼I܂ł͈ȑÕpCvCg.
+	void Invalidate(const std::vector<std::string>& shaders)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto& [state, entry] : m_entries)
+		{
+			if (std::none_of(shaders.begin(), shaders.end(), [&](const std::string& name) { return state.UsesShader(name); }))
+			{
+				continue;
+			}
+			if (entry.queued)
+			{
+				// 쐬̂̂͌Ât@Cǂł\̂ŁAɂx.
+				entry.dirty = true;
+			}
+			else
+			{
+				Queue(state, entry);
+			}
+		}
+	}
+
+	// CXbhŃt[̋L^̑OɌĂ. upCvC serial ̊ɔj.
+	// g悤ɂȂpCvC̐Ԃ.
+	uint32_t Update(uint64_t serial)
+	{
+		std::vector<Completed> completed;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			completed.swap(m_completed);
+		}
+		uint32_t published = 0;
+		for (auto& result : completed)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = m_entries.find(result.state);
+			if (it == m_entries.end())
+			{
+				vkDestroyPipeline(m_device, result.pipeline, nullptr);
+				continue;
+			}
+			auto& entry = it->second;
+			entry.queued = false;
+			if (result.pipeline != VK_NULL_HANDLE)
+			{
+				m_deletionQueue->Track(result.pipeline);
+				m_deletionQueue->Destroy(entry.pipeline, serial);
+				entry.pipeline = result.pipeline;
+				++published;
+			}
+			else
+			{
+				++m_failedCount;
+			}
+			if (entry.dirty && !m_quit)
+			{
+				entry.dirty = false;
+				Queue(it->first, entry);
+			}
+		}
+		return published;
+	}
+
+	// 쐬ς݂ǂ.
+	bool IsReady(const GraphicsPipelineState& state) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_entries.find(state);
+		return it != m_entries.end() && it->second.pipeline != VK_NULL_HANDLE;
+	}
+
+	std::string FormatStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return std::format("Pipelines: {} variants, {} compiles ({} failed), total {:.3f} ms, max {:.3f} ms on {} threads, {} fallback lookups.\n",
+			m_entries.size(), m_compileCount, m_failedCount, m_compileMs, m_maxCompileMs, m_threads.size(), m_fallbackCount);
+	}
+
+private:
+	struct Entry
+	{
+		VkPipeline pipeline = VK_NULL_HANDLE;
+		// 쐬҂܂͍쐬.
+		bool queued = false;
+		// 쐬ɃVF[_[XVꂽ.
+		bool dirty = false;
+	};
+
+	struct Completed
+	{
+		GraphicsPipelineState state;
+		VkPipeline pipeline;
+	};
+
+	struct StateHash
+	{
+		size_t operator()(const GraphicsPipelineState& state) const { return size_t(state.Hash()); }
+	};
+
+	// m_mutex 擾ԂŌĂ.
+	Entry& FindOrQueue(const GraphicsPipelineState& state)
+	{
+		auto [it, inserted] = m_entries.try_emplace(state);
+		if (inserted)
+		{
+			Queue(it->first, it->second);
+		}
+		return it->second;
+	}
+
+	void Queue(const GraphicsPipelineState& state, Entry& entry)
+	{
+		entry.queued = true;
+		m_queue.push_back(state);
+		m_wakeCv.notify_one();
+	}
+
+	void WorkerMain()
+	{
+		for (;;)
+		{
+			GraphicsPipelineState state;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wakeCv.wait(lock, [&]() { return m_quit || !m_queue.empty(); });
+				if (m_quit)
+				{
+					return;
+				}
+				state = std::move(m_queue.front());
+				m_queue.pop_front();
+			}
+
+			auto start = FrameProfiler::Clock::now();
+			auto pipeline = Compile(state);
+			auto ms = FrameProfiler::ElapsedMs(start, FrameProfiler::Clock::now());
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			++m_compileCount;
+			m_compileMs += ms;
+			m_maxCompileMs = std::max(m_maxCompileMs, ms);
+			m_completed.push_back(Completed{ .state = std::move(state), .pipeline = pipeline });
+		}
+	}
+
+	// r[|[gƃVU[͓IXe[gɂāA𑜓xςĂ蒼ɍςނ悤ɂ.
+	VkPipeline Compile(const GraphicsPipelineState& state) const
+	{
+		VkPipelineVertexInputStateCreateInfo vertexInput{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO
+		};
+
+		VkPipelineInputAssemblyStateCreateInfo inputAssembly{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+			.topology = state.topology,
+		};
+
+		VkPipelineRasterizationStateCreateInfo raster{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+			.polygonMode = state.polygonMode,
+			.cullMode = state.cullMode,
+			.frontFace = state.frontFace,
+			.lineWidth = 1.0f,
+		};
+
+		VkPipelineColorBlendAttachmentState blendAttachment{
+			.blendEnable = state.blendEnable ? VK_TRUE : VK_FALSE,
+			.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
+			.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+			.colorBlendOp = VK_BLEND_OP_ADD,
+			.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
+			.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
+			.alphaBlendOp = VK_BLEND_OP_ADD,
+			.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+		};
+
+		VkPipelineColorBlendStateCreateInfo blend{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+			.attachmentCount = 1,
+			.pAttachments = &blendAttachment
+		};
+
+		VkPipelineViewportStateCreateInfo viewport{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+			.viewportCount = 1,
+			.scissorCount = 1,
+		};
+
+		VkPipelineDepthStencilStateCreateInfo depthStencil{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO
+		};
+
+		VkPipelineMultisampleStateCreateInfo multisample{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+			.rasterizationSamples = state.samples,
+		};
+
+		std::array<VkDynamicState, 2> dynamics{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+
+		VkPipelineDynamicStateCreateInfo dynamic{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+			.dynamicStateCount = uint32_t(dynamics.size()),
+			.pDynamicStates = dynamics.data(),
+		};
+
+		std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages{{
+			{
+				.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+				.stage = VK_SHADER_STAGE_VERTEX_BIT,
+				.module = m_shaderLibrary->CreateModule(state.vertexShader),
+				.pName = "main",
+			},
+			{
+				.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+				.stage = VK_SHADER_STAGE_FRAGMENT_BIT,
+				.module = m_shaderLibrary->CreateModule(state.fragmentShader),
+				.pName = "main",
+			}
+		}};
+
+		VkPipelineRenderingCreateInfo renderingCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+			.colorAttachmentCount = 1,
+			.pColorAttachmentFormats = &state.colorFormat,
+		};
+
+		VkPipeline pipeline = VK_NULL_HANDLE;
+		if (shaderStages[0].module != VK_NULL_HANDLE && shaderStages[1].module != VK_NULL_HANDLE)
+		{
+			VkGraphicsPipelineCreateInfo pipelineCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+				.pNext = state.renderPass == VK_NULL_HANDLE ? &renderingCreateInfo : nullptr,
+				.stageCount = uint32_t(shaderStages.size()),
+				.pStages = shaderStages.data(),
+				.pVertexInputState = &vertexInput,
+				.pInputAssemblyState = &inputAssembly,
+				.pViewportState = &viewport,
+				.pRasterizationState = &raster,
+				.pMultisampleState = &multisample,
+				.pDepthStencilState = &depthStencil,
+				.pColorBlendState = &blend,
+				.pDynamicState = &dynamic,
+				.layout = state.layout,
+				.renderPass = state.renderPass,
+			};
+			// VkPipelineCache ͓œ̂ŁA[J[ԂŋLł.
+			if (vkCreateGraphicsPipelines(m_device, m_pipelineCache, 1, &pipelineCreateInfo, nullptr, &pipeline) != VK_SUCCESS)
+			{
+				pipeline = VK_NULL_HANDLE;
+			}
+		}
+
+		// W[̓pCvC̍쐬ɂ͕sv.
+		for (auto& stage : shaderStages)
+		{
+			if (stage.module != VK_NULL_HANDLE)
+			{
+				vkDestroyShaderModule(m_device, stage.module, nullptr);
+			}
+		}
+		return pipeline;
+	}
+
+	VkDevice m_device = VK_NULL_HANDLE;
+	ShaderLibrary* m_shaderLibrary = nullptr;
+	VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+	DeletionQueue* m_deletionQueue = nullptr;
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_wakeCv;
+	std::vector<std::thread> m_threads;
+	bool m_quit = false;
+	std::unordered_map<GraphicsPipelineState, Entry, StateHash> m_entries;
+	std::deque<GraphicsPipelineState> m_queue;
+	std::vector<Completed> m_completed;
+
+	uint64_t m_compileCount = 0;
+	uint64_t m_failedCount = 0;
+	uint64_t m_fallbackCount = 0;
+	double m_compileMs = 0.0;
+	double m_maxCompileMs = 0.0;
+};
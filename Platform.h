@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Volk/volk.h"
+#include "GLFW/glfw3.h"
+
+#include <memory>
+#include <vector>
+
+// fobOo. Windows ł̓fobKɁAȊOł͕WG[o͂ɏo.
+void OutputLog(const char* message);
+
+// EBhEX^C̕ύXƔrtXN[ȂǁAOS Ɉˑ鏈.
+// `̃zbgpX͌Ă΂Ȃ.  Platform*.cpp ɕAOS ̃wb_͂œǂݍ.
+class Platform
+{
+public:
+	// VkFullScreenExclusiveEXT ɑΉ. rtXN[ł͏ɖ.
+	enum class FullScreenExclusive
+	{
+		Default,
+		Disallowed,
+		Allowed,
+		ApplicationControlled,
+	};
+
+	virtual ~Platform() = default;
+
+	// CX^XƃfoCXɒǉŕKvȊg@\. EBhEɕ`悷ꍇg.
+	virtual std::vector<const char*> GetInstanceExtensions() const = 0;
+	virtual std::vector<const char*> GetDeviceExtensions() const = 0;
+
+	// EBhE̍쐬ɌĂ. EBhE[hɖ߂߂̏Ԃۑ.
+	virtual void AttachWindow(GLFWwindow* window) = 0;
+	// CxgXbhĂ. fullscreen Ȃ烂j^Ŝ𕢂gȂ̃EBhEɂ.
+	virtual void ApplyWindowStyle(bool fullscreen) = 0;
+
+	// ɍXbv`FC̔rtXN[̈߂.
+	virtual void SetFullScreenExclusive(FullScreenExclusive mode) = 0;
+	virtual FullScreenExclusive GetFullScreenExclusive() const = 0;
+	// VkSwapchainCreateInfoKHR::pNext Ɍq\.  nullptr.
+	virtual const void* GetSwapchainCreateInfoNext() const = 0;
+	// ApplicationControlled ōXbv`FCɑ΂ČĂ.
+	virtual VkResult AcquireFullScreenExclusive(VkDevice device, VkSwapchainKHR swapchain) = 0;
+	virtual void ReleaseFullScreenExclusive(VkDevice device, VkSwapchainKHR swapchain) = 0;
+
+	// słȂG[𗘗p҂ɒm点.
+	virtual void ShowError(const char* message) = 0;
+};
+
+// s OS ̎.
+std::unique_ptr<Platform> CreatePlatform();
@@ -0,0 +1,99 @@
+#if !defined(_WIN32)
+
+#include "Platform.h"
+
+#include <cstdio>
+
+void OutputLog(const char* message)
+{
+	std::fputs(message, stderr);
+}
+
+// Windows ȊO (X11 / Wayland) ̎. EBhȆ GLFW ɔC.
+// rtXN[̊g@\͖̂ŁA{[_[XƓɂȂ.
+class GlfwPlatform : public Platform
+{
+public:
+	std::vector<const char*> GetInstanceExtensions() const override
+	{
+		return {};
+	}
+
+	std::vector<const char*> GetDeviceExtensions() const override
+	{
+		return {};
+	}
+
+	void AttachWindow(GLFWwindow* window) override
+	{
+		m_window = window;
+	}
+
+	void ApplyWindowStyle(bool fullscreen) override
+	{
+		bool current = glfwGetWindowMonitor(m_window) != nullptr;
+		if (fullscreen == current)
+		{
+			return;
+		}
+		if (fullscreen)
+		{
+			// EBhE[hɖ߂߂̈ʒuƑ傫ۑ. Wayland ł͈ʒu͎擾łȂ.
+			glfwGetWindowPos(m_window, &m_windowX, &m_windowY);
+			glfwGetWindowSize(m_window, &m_windowWidth, &m_windowHeight);
+
+			// Wayland ł̓EBhE𓮂Ȃ̂ŁAj^w肵tXN[ŕ.
+			// j^̉𑜓xƃtbV[g͕ςȂ.
+			auto monitor = glfwGetPrimaryMonitor();
+			auto mode = glfwGetVideoMode(monitor);
+			glfwSetWindowMonitor(m_window, monitor, 0, 0, mode->width, mode->height, mode->refreshRate);
+		}
+		else
+		{
+			glfwSetWindowMonitor(m_window, nullptr, m_windowX, m_windowY, m_windowWidth, m_windowHeight, GLFW_DONT_CARE);
+		}
+	}
+
+	void SetFullScreenExclusive(FullScreenExclusive) override
+	{
+	}
+
+	FullScreenExclusive GetFullScreenExclusive() const override
+	{
+		return FullScreenExclusive::Default;
+	}
+
+	const void* GetSwapchainCreateInfoNext() const override
+	{
+		return nullptr;
+	}
+
+	VkResult AcquireFullScreenExclusive(VkDevice, VkSwapchainKHR) override
+	{
+		return VK_ERROR_EXTENSION_NOT_PRESENT;
+	}
+
+	void ReleaseFullScreenExclusive(VkDevice, VkSwapchainKHR) override
+	{
+	}
+
+	void ShowError(const char* message) override
+	{
+		OutputLog(message);
+		OutputLog("\n");
+	}
+
+private:
+	GLFWwindow* m_window = nullptr;
+	int m_windowX = 0;
+	int m_windowY = 0;
+	int m_windowWidth = 0;
+	int m_windowHeight = 0;
+};
+
+std::unique_ptr<Platform> CreatePlatform()
+{
+	return std::make_unique<GlfwPlatform>();
+}
+
+#endif
@@ -0,0 +1,160 @@
+#if defined(_WIN32)
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+#define VK_NO_PROTOTYPES
+#define VK_USE_PLATFORM_WIN32_KHR
+#include "Platform.h"
+
+#define GLFW_EXPOSE_NATIVE_WIN32
+#include "GLFW/glfw3native.h"
+
+#include <format>
+
+void OutputLog(const char* message)
+{
+	OutputDebugStringA(message);
+}
+
+// EBhEX^C𒼐ڏă{[_[XɂAVK_EXT_full_screen_exclusive ŔrtXN[𐧌䂷.
+class Win32Platform : public Platform
+{
+public:
+	Win32Platform()
+	{
+		m_fullScreenExclusiveInfo.sType = VK_STRUCTURE_TYPE_SURFACE_FULL_SCREEN_EXCLUSIVE_INFO_EXT;
+		m_fullScreenExclusiveWin32Info.sType = VK_STRUCTURE_TYPE_SURFACE_FULL_SCREEN_EXCLUSIVE_WIN32_INFO_EXT;
+		m_fullScreenExclusiveInfo.pNext = &m_fullScreenExclusiveWin32Info;
+		m_fullScreenExclusiveInfo.fullScreenExclusive = VK_FULL_SCREEN_EXCLUSIVE_DEFAULT_EXT;
+	}
+
+	std::vector<const char*> GetInstanceExtensions() const override
+	{
+		// VK_EXT_full_screen_exclusivê߂Ɉˑg@\L.
+		return { VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME, VK_KHR_GET_SURFACE_CAPABILITIES_2_EXTENSION_NAME };
+	}
+
+	std::vector<const char*> GetDeviceExtensions() const override
+	{
+		return { VK_EXT_FULL_SCREEN_EXCLUSIVE_EXTENSION_NAME };
+	}
+
+	void AttachWindow(GLFWwindow* window) override
+	{
+		m_hwnd = glfwGetWin32Window(window);
+		m_fullScreenExclusiveWin32Info.hmonitor = MonitorFromWindow(m_hwnd, MONITOR_DEFAULTTONEAREST);
+
+		// ݂̃EBhEԂۑ.
+		m_windowStyle = GetWindowLongA(m_hwnd, GWL_STYLE);
+		m_windowStyleEx = GetWindowLongA(m_hwnd, GWL_EXSTYLE);
+
+		GetWindowPlacement(m_hwnd, &m_wpc);
+	}
+
+	void ApplyWindowStyle(bool fullscreen) override
+	{
+		if (!fullscreen)
+		{
+			SetWindowLongA(m_hwnd, GWL_STYLE, m_windowStyle);
+			SetWindowLongA(m_hwnd, GWL_EXSTYLE, m_windowStyleEx);
+			ShowWindow(m_hwnd, SW_SHOWNORMAL);
+			SetWindowPlacement(m_hwnd, &m_wpc);
+		}
+		else
+		{
+			LONG newStyle = m_windowStyle & (~WS_BORDER) & (~WS_DLGFRAME) & (~WS_THICKFRAME);
+			LONG newStyleEx = m_windowStyleEx & (~WS_EX_WINDOWEDGE);
+			newStyle |= WS_POPUP;
+			newStyleEx |= WS_EX_TOPMOST;
+			SetWindowLongA(m_hwnd, GWL_STYLE, newStyle);
+			SetWindowLongA(m_hwnd, GWL_EXSTYLE, newStyleEx);
+			ShowWindow(m_hwnd, SW_SHOWMAXIMIZED);
+		}
+	}
+
+	void SetFullScreenExclusive(FullScreenExclusive mode) override
+	{
+		m_mode = mode;
+		switch (mode)
+		{
+		case FullScreenExclusive::Disallowed:
+			m_fullScreenExclusiveInfo.fullScreenExclusive = VK_FULL_SCREEN_EXCLUSIVE_DISALLOWED_EXT;
+			break;
+		case FullScreenExclusive::Allowed:
+			m_fullScreenExclusiveInfo.fullScreenExclusive = VK_FULL_SCREEN_EXCLUSIVE_ALLOWED_EXT;
+			break;
+		case FullScreenExclusive::ApplicationControlled:
+			m_fullScreenExclusiveInfo.fullScreenExclusive = VK_FULL_SCREEN_EXCLUSIVE_APPLICATION_CONTROLLED_EXT;
+			break;
+		default:
+			m_fullScreenExclusiveInfo.fullScreenExclusive = VK_FULL_SCREEN_EXCLUSIVE_DEFAULT_EXT;
+			break;
+		}
+	}
+
+	FullScreenExclusive GetFullScreenExclusive() const override
+	{
+		return m_mode;
+	}
+
+	const void* GetSwapchainCreateInfoNext() const override
+	{
+		return &m_fullScreenExclusiveInfo;
+	}
+
+	VkResult AcquireFullScreenExclusive(VkDevice device, VkSwapchainKHR swapchain) override
+	{
+		LoadDeviceFunctions(device);
+		auto res = m_acquireFullScreenExclusiveMode(device, swapchain);
+		if (res != VK_SUCCESS)
+		{
+			auto str = std::format("vkAcquireFullScreenExclusiveModeEXT failed. (result = {:d})\n", (int)res);
+			OutputLog(str.c_str());
+		}
+		return res;
+	}
+
+	void ReleaseFullScreenExclusive(VkDevice device, VkSwapchainKHR swapchain) override
+	{
+		LoadDeviceFunctions(device);
+		m_releaseFullScreenExclusiveMode(device, swapchain);
+	}
+
+	void ShowError(const char* message) override
+	{
+		MessageBoxA(NULL, message, "Error", MB_OK);
+	}
+
+private:
+	// volk ̖̎|Pʂł VK_USE_PLATFORM_WIN32_KHR `Ȃ̂ŁAg@\̊֐͂Ŏ擾.
+	void LoadDeviceFunctions(VkDevice device)
+	{
+		if (m_acquireFullScreenExclusiveMode == nullptr)
+		{
+			m_acquireFullScreenExclusiveMode = reinterpret_cast<PFN_vkAcquireFullScreenExclusiveModeEXT>(
+				vkGetDeviceProcAddr(device, "vkAcquireFullScreenExclusiveModeEXT"));
+			m_releaseFullScreenExclusiveMode = reinterpret_cast<PFN_vkReleaseFullScreenExclusiveModeEXT>(
+				vkGetDeviceProcAddr(device, "vkReleaseFullScreenExclusiveModeEXT"));
+		}
+	}
+
+	HWND m_hwnd = nullptr;
+	LONG m_windowStyle = 0;
+	LONG m_windowStyleEx = 0;
+	WINDOWPLACEMENT m_wpc{ .length = sizeof(WINDOWPLACEMENT) };
+
+	FullScreenExclusive m_mode = FullScreenExclusive::Default;
+	VkSurfaceFullScreenExclusiveInfoEXT m_fullScreenExclusiveInfo = {};
+	VkSurfaceFullScreenExclusiveWin32InfoEXT m_fullScreenExclusiveWin32Info = {};
+	PFN_vkAcquireFullScreenExclusiveModeEXT m_acquireFullScreenExclusiveMode = nullptr;
+	PFN_vkReleaseFullScreenExclusiveModeEXT m_releaseFullScreenExclusiveMode = nullptr;
+};
+
+std::unique_ptr<Platform> CreatePlatform()
+{
+	return std::make_unique<Win32Platform>();
+}
+
+#endif
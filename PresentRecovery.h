@@ -0,0 +1,272 @@
+#pragma once
+
+#include "Volk/volk.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Xbv`FC̎擾Ev[g̎s畜A邽߂̏ԑJ.
+// VK_ERROR_OUT_OF_DATE_KHR  VK_SUBOPTIMAL_KHR ̓Xbv`FC蒼A
+// rtXN[ꍇ̓{[_[XɗƂāAtH[JX߂r蒼.
+// s玟Ƀv[g܂ł̎ԂAƂɕAԂƂďWv.
+// `XbhĂ.
+class PresentRecovery
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	enum class State
+	{
+		// ɕ\Ă.
+		Presenting,
+		// Xbv`FC蒼Av[g̐҂Ă.
+		Recreating,
+		// rtXN[A{[_[Xŕ\ȂtH[JX߂̂҂Ă.
+		WaitingForFocus,
+		// rtXN[蒼Av[g̐҂Ă.
+		Restoring,
+	};
+
+	// Ăяõt[̑Oɍsu.
+	enum class Action
+	{
+		None,
+		RecreateSwapchain,
+		FallBackToBorderless,
+		RestoreExclusive,
+		// AłȂ. `惋[vI.
+		Exit,
+	};
+
+	// pɒłQ.
+	enum class Fault
+	{
+		OutOfDate,
+		Suboptimal,
+		ExclusiveLost,
+		// EBhEtH[JX߂.
+		FocusGained,
+	};
+
+	// "out_of_date@100,suboptimal@150,exclusive_lost@200,focus@230" ̌`ŁAt[ԍƂ̏Qw肷.
+	// ߂łȂڂ false ԂA̍ڂ͖.
+	bool ParseFaults(std::string_view spec)
+	{
+		bool valid = true;
+		while (!spec.empty())
+		{
+			auto comma = spec.find(',');
+			auto item = spec.substr(0, comma);
+			spec = (comma == std::string_view::npos) ? std::string_view{} : spec.substr(comma + 1);
+
+			auto at = item.find('@');
+			auto name = item.substr(0, at);
+			auto it = std::find_if(FaultNames.begin(), FaultNames.end(), [&](auto& v) { return name == v.second; });
+			uint64_t frame = 0;
+			if (at == std::string_view::npos || it == FaultNames.end() ||
+				std::from_chars(item.data() + at + 1, item.data() + item.size(), frame).ec != std::errc{})
+			{
+				valid = false;
+				continue;
+			}
+			m_faults.push_back({ frame, it->first });
+		}
+		std::sort(m_faults.begin(), m_faults.end(), [](auto& a, auto& b) { return a.frame < b.frame; });
+		return valid;
+	}
+
+	// frame ̃v[ǧʂɁÃt[ɒQ𔽉f.
+	// ۂ̃v[g͍ςł̂ŁAǂ̓샂[hłSɑJڂʂ.
+	VkResult InjectFault(uint64_t frame, VkResult result, bool* focusGained)
+	{
+		*focusGained = false;
+		while (m_nextFault < m_faults.size() && m_faults[m_nextFault].frame <= frame)
+		{
+			switch (m_faults[m_nextFault++].fault)
+			{
+			case Fault::OutOfDate:
+				result = VK_ERROR_OUT_OF_DATE_KHR;
+				break;
+			case Fault::Suboptimal:
+				result = VK_SUBOPTIMAL_KHR;
+				break;
+			case Fault::ExclusiveLost:
+				result = VK_ERROR_FULL_SCREEN_EXCLUSIVE_MODE_LOST_EXT;
+				break;
+			case Fault::FocusGained:
+				*focusGained = true;
+				break;
+			}
+		}
+		return result;
+	}
+
+	// 擾܂̓v[ǧʂ珈u߂. exclusive ͔rtXN[ŕ\Ă邩.
+	Action OnResult(VkResult result, bool exclusive)
+	{
+		switch (result)
+		{
+		case VK_SUCCESS:
+			return Action::None;
+		case VK_SUBOPTIMAL_KHR:
+		case VK_ERROR_OUT_OF_DATE_KHR:
+			BeginMeasure(result == VK_SUBOPTIMAL_KHR ? Suboptimal : OutOfDate);
+			if (m_state == State::Presenting)
+			{
+				m_state = State::Recreating;
+			}
+			return Action::RecreateSwapchain;
+		case VK_ERROR_FULL_SCREEN_EXCLUSIVE_MODE_LOST_EXT:
+			if (!exclusive)
+			{
+				// rŖ΍蒼ł悢.
+				return OnResult(VK_ERROR_OUT_OF_DATE_KHR, false);
+			}
+			BeginMeasure(ExclusiveLost);
+			m_state = State::WaitingForFocus;
+			return Action::FallBackToBorderless;
+		default:
+			return Action::Exit;
+		}
+	}
+
+	Action OnFocusChanged(bool focused)
+	{
+		if (!focused || m_state != State::WaitingForFocus)
+		{
+			return Action::None;
+		}
+		BeginMeasure(ExclusiveRestored);
+		m_state = State::Restoring;
+		return Action::RestoreExclusive;
+	}
+
+	// p҂ʃ[hIђAr̎蒼͂߂.
+	void Cancel()
+	{
+		m_state = State::Presenting;
+		m_measuring = false;
+	}
+
+	// v[gɐĂ.
+	void OnPresented()
+	{
+		if (m_measuring)
+		{
+			auto ms = std::chrono::duration<double, std::milli>(Clock::now() - m_measureStart).count();
+			auto& stats = m_stats[m_measureReason];
+			++stats.count;
+			stats.totalMs += ms;
+			stats.maxMs = std::max(stats.maxMs, ms);
+			m_measuring = false;
+		}
+		if (m_state == State::Recreating || m_state == State::Restoring)
+		{
+			m_state = State::Presenting;
+		}
+	}
+
+	State GetState() const { return m_state; }
+
+	// ׂĂ̌܂Ƃ߂Ả񐔁EρEő (~b).
+	uint64_t GetRecoveryCount() const
+	{
+		uint64_t count = 0;
+		for (auto& stats : m_stats)
+		{
+			count += stats.count;
+		}
+		return count;
+	}
+	double GetMeanRecoveryMs() const
+	{
+		double total = 0.0;
+		for (auto& stats : m_stats)
+		{
+			total += stats.totalMs;
+		}
+		auto count = GetRecoveryCount();
+		return count > 0 ? total / double(count) : 0.0;
+	}
+	double GetMaxRecoveryMs() const
+	{
+		double maxMs = 0.0;
+		for (auto& stats : m_stats)
+		{
+			maxMs = std::max(maxMs, stats.maxMs);
+		}
+		return maxMs;
+	}
+
+	std::string FormatStats() const
+	{
+		std::string str;
+		for (size_t i = 0; i < m_stats.size(); ++i)
+		{
+			auto& stats = m_stats[i];
+			if (stats.count > 0)
+			{
+				str += std::format("Recovery from {}: {} times, mean {:.3f} ms, max {:.3f} ms\n",
+					ReasonNames[i], stats.count, stats.totalMs / double(stats.count), stats.maxMs);
+			}
+		}
+		return str;
+	}
+
+private:
+	enum Reason
+	{
+		OutOfDate,
+		Suboptimal,
+		ExclusiveLost,
+		ExclusiveRestored,
+		ReasonCount,
+	};
+	static constexpr std::array<const char*, ReasonCount> ReasonNames = { "out_of_date", "suboptimal", "exclusive_lost", "exclusive_restored" };
+	static constexpr std::array<std::pair<Fault, std::string_view>, 4> FaultNames{{
+		{ Fault::OutOfDate, "out_of_date" },
+		{ Fault::Suboptimal, "suboptimal" },
+		{ Fault::ExclusiveLost, "exclusive_lost" },
+		{ Fault::FocusGained, "focus" },
+	}};
+
+	struct ScheduledFault
+	{
+		uint64_t frame = 0;
+		Fault fault = Fault::OutOfDate;
+	};
+
+	struct RecoveryStats
+	{
+		uint64_t count = 0;
+		double totalMs = 0.0;
+		double maxMs = 0.0;
+	};
+
+	// AɎ̎sNꍇ́Aŏ̎s瑪葱.
+	void BeginMeasure(Reason reason)
+	{
+		if (!m_measuring || reason == ExclusiveRestored)
+		{
+			m_measureReason = reason;
+			m_measureStart = Clock::now();
+			m_measuring = true;
+		}
+	}
+
+	State m_state = State::Presenting;
+	bool m_measuring = false;
+	Reason m_measureReason = OutOfDate;
+	Clock::time_point m_measureStart;
+	std::array<RecoveryStats, ReasonCount> m_stats{};
+
+	std::vector<ScheduledFault> m_faults;
+	size_t m_nextFault = 0;
+};
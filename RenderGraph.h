@@ -0,0 +1,641 @@
+#pragma once
+
+#include "Volk/volk.h"
+#include "DeletionQueue.h"
+#include "GpuAllocator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <string>
+#include <vector>
+
+// 1t[̕`pXƃC[W̓ǂݏŐ錾AsɕKvȂ̂Oɋ߂.
+// - o (v[gC[WȂ) Ɋ^ȂpX͎sȂ.
+// - pX̒OɕKvȃoA߁ApXƂ 1  vkCmdPipelineBarrier2 ɂ܂Ƃ߂.
+// - OtŎgꎞC[ẂAgpԂdȂȂ̓mœL.
+// \ςƂ (Xbv`FC̍蒼Ȃ)  Compile() At[ Execute() .
+// `XbhĂ.
+class RenderGraph
+{
+public:
+	using ResourceId = uint32_t;
+	static constexpr ResourceId InvalidResource = UINT32_MAX;
+
+	// pXł̃C[W̎g. CAEgƃXe[WEANZX͂猈܂.
+	enum class Usage
+	{
+		ColorAttachment,
+		TransferSrc,
+		TransferDst,
+		Sampled,
+	};
+
+	struct ImageState
+	{
+		VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+		VkPipelineStageFlags2 stage = VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT;
+		VkAccessFlags2 access = VK_ACCESS_2_NONE;
+	};
+
+	struct Access
+	{
+		ResourceId resource = InvalidResource;
+		Usage usage = Usage::ColorAttachment;
+	};
+
+	// pipelineBarrier2  nullptr Ȃ (synchronization2 gȂ) vkCmdPipelineBarrier ɕϊċL^.
+	void Initialize(VkDevice device, GpuAllocator& allocator, DeletionQueue& deletionQueue, PFN_vkCmdPipelineBarrier2 pipelineBarrier2)
+	{
+		m_device = device;
+		m_allocator = &allocator;
+		m_deletionQueue = &deletionQueue;
+		m_pipelineBarrier2 = pipelineBarrier2;
+	}
+
+	// pXƃ\[XׂĎ菜. ꎞC[W serial ̃t[Ăj.
+	void Reset(uint64_t serial)
+	{
+		for (auto& resource : m_resources)
+		{
+			if (!resource.imported)
+			{
+				m_deletionQueue->Destroy(resource.view, serial);
+				m_deletionQueue->Destroy(resource.image, serial);
+			}
+		}
+		m_allocator->Free(m_memory, serial);
+		m_resources.clear();
+		m_passes.clear();
+		m_finalBarriers.clear();
+		m_compiled = false;
+	}
+
+	// Ot̊OōC[W. ͖̂t[ SetImportedImage() œn.
+	// output ȂÃC[Wւ݂͕̏svłȂȂ.
+	ResourceId ImportImage(const char* name, VkFormat format, VkExtent2D extent, ImageState initial, ImageState final, bool output)
+	{
+		m_resources.push_back(Resource{
+			.name = name, .format = format, .extent = extent,
+			.imported = true, .output = output, .initial = initial, .final = final,
+		});
+		return ResourceId(m_resources.size() - 1);
+	}
+
+	// OtŎgꎞC[W. pr͐錾ꂽpXł̎g猈߂.
+	ResourceId CreateImage(const char* name, VkFormat format, VkExtent2D extent)
+	{
+		m_resources.push_back(Resource{ .name = name, .format = format, .extent = extent });
+		return ResourceId(m_resources.size() - 1);
+	}
+
+	void SetImportedImage(ResourceId id, VkImage image, VkImageView view)
+	{
+		m_resources[id].image = image;
+		m_resources[id].view = view;
+	}
+
+	// \[X reads  writes ̗ɏꍇ́Agɂ.
+	void AddPass(const char* name, std::vector<Access> reads, std::vector<Access> writes, std::function<void(VkCommandBuffer)> record)
+	{
+		m_passes.push_back(Pass{ .name = name, .reads = std::move(reads), .writes = std::move(writes), .record = std::move(record) });
+	}
+
+	VkImage GetImage(ResourceId id) const { return m_resources[id].image; }
+	VkImageView GetView(ResourceId id) const { return m_resources[id].view; }
+
+	// svȃpX̏AꎞC[W̊mہAoǍvZs. ꎞC[WmۂłȂ false.
+	bool Compile()
+	{
+		CullPasses();
+		ComputeLifetimes();
+		if (!AllocateTransients())
+		{
+			return false;
+		}
+		ComputeBarriers();
+		m_compiled = true;
+		return true;
+	}
+
+	void Execute(VkCommandBuffer commandBuffer)
+	{
+		for (auto& pass : m_passes)
+		{
+			if (pass.culled)
+			{
+				continue;
+			}
+			RecordBarriers(commandBuffer, pass.barriers);
+			pass.record(commandBuffer);
+		}
+		RecordBarriers(commandBuffer, m_finalBarriers);
+	}
+
+	bool IsCompiled() const { return m_compiled; }
+
+	// 1t[ŋL^oA̐ vkCmdPipelineBarrier2 ̌Ăяo.
+	uint32_t GetBarrierCount() const
+	{
+		auto count = uint32_t(m_finalBarriers.size());
+		for (auto& pass : m_passes)
+		{
+			count += pass.culled ? 0 : uint32_t(pass.barriers.size());
+		}
+		return count;
+	}
+	uint32_t GetBarrierBatchCount() const
+	{
+		uint32_t count = m_finalBarriers.empty() ? 0 : 1;
+		for (auto& pass : m_passes)
+		{
+			count += (!pass.culled && !pass.barriers.empty()) ? 1 : 0;
+		}
+		return count;
+	}
+
+	std::string FormatSummary() const
+	{
+		auto culled = std::ranges::count_if(m_passes, [](auto& pass) { return pass.culled; });
+		return std::format("Render graph: {} passes ({} culled), {} barriers in {} batches, transient memory {} KiB (unaliased {} KiB).\n",
+			m_passes.size(), culled, GetBarrierCount(), GetBarrierBatchCount(), m_memoryBytes >> 10, m_unaliasedBytes >> 10);
+	}
+
+	// RpCʂlǂ߂`ŕԂ.
+	std::string Dump() const
+	{
+		auto str = FormatSummary();
+		for (size_t i = 0; i < m_passes.size(); ++i)
+		{
+			auto& pass = m_passes[i];
+			str += std::format("pass {} {}{}\n", i, pass.name, pass.culled ? " (culled)" : "");
+			for (auto& access : pass.reads)
+			{
+				str += std::format("  read  {} as {}\n", m_resources[access.resource].name, UsageName(access.usage));
+			}
+			for (auto& access : pass.writes)
+			{
+				str += std::format("  write {} as {}\n", m_resources[access.resource].name, UsageName(access.usage));
+			}
+			if (!pass.culled)
+			{
+				str += DumpBarriers(pass.barriers);
+			}
+		}
+		if (!m_finalBarriers.empty())
+		{
+			str += "end of frame\n";
+			str += DumpBarriers(m_finalBarriers);
+		}
+		for (auto& resource : m_resources)
+		{
+			str += std::format("resource {}: {}x{}, ", resource.name, resource.extent.width, resource.extent.height);
+			if (resource.imported)
+			{
+				str += std::format("imported{}\n", resource.output ? ", output" : "");
+			}
+			else if (resource.firstPass == UINT32_MAX)
+			{
+				str += "transient, unused\n";
+			}
+			else
+			{
+				str += std::format("transient, passes {}-{}, offset {} KiB, {} KiB\n",
+					resource.firstPass, resource.lastPass, resource.memoryOffset >> 10, resource.memorySize >> 10);
+			}
+		}
+		return str;
+	}
+
+private:
+	struct Resource
+	{
+		const char* name = "";
+		VkFormat format = VK_FORMAT_UNDEFINED;
+		VkExtent2D extent{};
+		bool imported = false;
+		bool output = false;
+		ImageState initial;
+		ImageState final;
+
+		VkImage image = VK_NULL_HANDLE;
+		VkImageView view = VK_NULL_HANDLE;
+		// cpX̒Ŏg͈. gȂ UINT32_MAX.
+		uint32_t firstPass = UINT32_MAX;
+		uint32_t lastPass = 0;
+		Usage lastUsage = Usage::ColorAttachment;
+		VkImageUsageFlags usageFlags = 0;
+		VkDeviceSize memoryOffset = 0;
+		VkDeviceSize memorySize = 0;
+	};
+
+	struct Barrier
+	{
+		ResourceId resource = InvalidResource;
+		VkImageMemoryBarrier2 barrier{};
+	};
+
+	struct Pass
+	{
+		const char* name = "";
+		std::vector<Access> reads;
+		std::vector<Access> writes;
+		std::function<void(VkCommandBuffer)> record;
+		bool culled = false;
+		std::vector<Barrier> barriers;
+	};
+
+	static ImageState GetState(Usage usage, bool write)
+	{
+		switch (usage)
+		{
+		case Usage::TransferSrc:
+			return { VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT };
+		case Usage::TransferDst:
+			return { VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT };
+		case Usage::Sampled:
+			return { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT };
+		default:
+			return { VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+				write ? VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT : VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT };
+		}
+	}
+
+	static VkImageUsageFlags GetUsageFlags(Usage usage)
+	{
+		switch (usage)
+		{
+		case Usage::TransferSrc: return VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+		case Usage::TransferDst: return VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+		case Usage::Sampled: return VK_IMAGE_USAGE_SAMPLED_BIT;
+		default: return VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		}
+	}
+
+	static bool HasWrite(VkAccessFlags2 access)
+	{
+		constexpr VkAccessFlags2 writes = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+			VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+		return (access & writes) != 0;
+	}
+
+	static bool Contains(const std::vector<Access>& accesses, ResourceId id)
+	{
+		return std::ranges::any_of(accesses, [&](auto& access) { return access.resource == id; });
+	}
+
+	// o͂tɂǂAo͂ɓ͂Ȃ݂ȂpX.
+	// ǂ܂ɏ㏑鏑݂svƂĈ.
+	void CullPasses()
+	{
+		std::vector<bool> needed(m_resources.size());
+		for (size_t i = 0; i < m_resources.size(); ++i)
+		{
+			needed[i] = m_resources[i].output;
+		}
+		for (auto it = m_passes.rbegin(); it != m_passes.rend(); ++it)
+		{
+			auto& pass = *it;
+			pass.culled = !std::ranges::any_of(pass.writes, [&](auto& access) { return bool(needed[access.resource]); });
+			if (pass.culled)
+			{
+				continue;
+			}
+			for (auto& access : pass.writes)
+			{
+				needed[access.resource] = Contains(pass.reads, access.resource);
+			}
+			for (auto& access : pass.reads)
+			{
+				needed[access.resource] = true;
+			}
+		}
+	}
+
+	void ComputeLifetimes()
+	{
+		for (uint32_t i = 0; i < uint32_t(m_passes.size()); ++i)
+		{
+			if (m_passes[i].culled)
+			{
+				continue;
+			}
+			for (auto* accesses : { &m_passes[i].reads, &m_passes[i].writes })
+			{
+				for (auto& access : *accesses)
+				{
+					auto& resource = m_resources[access.resource];
+					resource.firstPass = std::min(resource.firstPass, i);
+					resource.lastPass = i;
+					resource.lastUsage = access.usage;
+					resource.usageFlags |= GetUsageFlags(access.usage);
+				}
+			}
+		}
+	}
+
+	static bool Overlaps(const Resource& a, const Resource& b)
+	{
+		bool lifetime = a.firstPass <= b.lastPass && b.firstPass <= a.lastPass;
+		bool memory = a.memoryOffset < b.memoryOffset + b.memorySize && b.memoryOffset < a.memoryOffset + a.memorySize;
+		return lifetime && memory;
+	}
+
+	// ꎞC[W傫ɁAgpԂ̏dȂC[WƏdȂȂłႢItZbgɒuA
+	// Ŝ 1 ̃Ɋmۂ.
+	bool AllocateTransients()
+	{
+		std::vector<ResourceId> transients;
+		std::vector<VkMemoryRequirements> requirements(m_resources.size());
+		uint32_t memoryTypeBits = ~0u;
+		VkDeviceSize alignment = 1;
+		m_unaliasedBytes = 0;
+		for (ResourceId id = 0; id < ResourceId(m_resources.size()); ++id)
+		{
+			auto& resource = m_resources[id];
+			if (resource.imported || resource.firstPass == UINT32_MAX)
+			{
+				continue;
+			}
+			VkImageCreateInfo imageCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+				.imageType = VK_IMAGE_TYPE_2D,
+				.format = resource.format,
+				.extent = { resource.extent.width, resource.extent.height, 1 },
+				.mipLevels = 1,
+				.arrayLayers = 1,
+				.samples = VK_SAMPLE_COUNT_1_BIT,
+				.tiling = VK_IMAGE_TILING_OPTIMAL,
+				.usage = resource.usageFlags,
+				.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+				.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+			};
+			vkCreateImage(m_device, &imageCreateInfo, nullptr, &resource.image);
+			m_deletionQueue->Track(resource.image);
+			vkGetImageMemoryRequirements(m_device, resource.image, &requirements[id]);
+			resource.memorySize = requirements[id].size;
+			memoryTypeBits &= requirements[id].memoryTypeBits;
+			alignment = std::max(alignment, requirements[id].alignment);
+			m_unaliasedBytes += requirements[id].size;
+			transients.push_back(id);
+		}
+		m_memoryBytes = 0;
+		if (transients.empty())
+		{
+			return true;
+		}
+		if (memoryTypeBits == 0)
+		{
+			// ʂ̃^Cv. ۂ̃foCXł͋NȂ̂ŁAΉsƂ.
+			return false;
+		}
+
+		std::ranges::sort(transients, [&](auto a, auto b) { return m_resources[a].memorySize > m_resources[b].memorySize; });
+		for (size_t i = 0; i < transients.size(); ++i)
+		{
+			auto& resource = m_resources[transients[i]];
+			resource.memoryOffset = 0;
+			// uC[WƏdȂԂ́Ǎ̖ɂ炵Ă.
+			for (bool moved = true; moved;)
+			{
+				moved = false;
+				for (size_t j = 0; j < i; ++j)
+				{
+					auto& placed = m_resources[transients[j]];
+					if (Overlaps(resource, placed))
+					{
+						auto end = placed.memoryOffset + placed.memorySize;
+						resource.memoryOffset = (end + requirements[transients[i]].alignment - 1) / requirements[transients[i]].alignment * requirements[transients[i]].alignment;
+						moved = true;
+					}
+				}
+			}
+			m_memoryBytes = std::max(m_memoryBytes, resource.memoryOffset + resource.memorySize);
+		}
+
+		VkMemoryRequirements heapRequirements{ .size = m_memoryBytes, .alignment = alignment, .memoryTypeBits = memoryTypeBits };
+		m_memory = m_allocator->Allocate(heapRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, false);
+		if (!m_memory.IsValid())
+		{
+			return false;
+		}
+		for (auto id : transients)
+		{
+			auto& resource = m_resources[id];
+			vkBindImageMemory(m_device, resource.image, m_memory.memory, m_memory.offset + resource.memoryOffset);
+
+			VkImageViewCreateInfo viewCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+				.image = resource.image,
+				.viewType = VK_IMAGE_VIEW_TYPE_2D,
+				.format = resource.format,
+				.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+			};
+			vkCreateImageView(m_device, &viewCreateInfo, nullptr, &resource.view);
+			m_deletionQueue->Track(resource.view);
+		}
+		return true;
+	}
+
+	// ꎞC[W̍ŏ̎gṕAg̃C[W (Õt[̎܂) ̍Ō̎gp҂.
+	ImageState GetTransientInitialState(ResourceId id) const
+	{
+		ImageState state{ .stage = VK_PIPELINE_STAGE_2_NONE };
+		auto& resource = m_resources[id];
+		for (auto& other : m_resources)
+		{
+			bool shared = !other.imported && other.firstPass != UINT32_MAX &&
+				resource.memoryOffset < other.memoryOffset + other.memorySize && other.memoryOffset < resource.memoryOffset + resource.memorySize;
+			if (shared)
+			{
+				auto last = GetState(other.lastUsage, true);
+				state.stage |= last.stage;
+				state.access |= HasWrite(last.access) ? last.access : VK_ACCESS_2_NONE;
+			}
+		}
+		return state;
+	}
+
+	// ǂݎ蓯mœCAEgȂ҂킹͗vȂ. ȊO̓oAu.
+	void ComputeBarriers()
+	{
+		// ꎞC[W͍ŏ̎gpőO̓êĂ̂ŁAUNDEFINED n߂.
+		std::vector<ImageState> states(m_resources.size());
+		for (ResourceId id = 0; id < ResourceId(m_resources.size()); ++id)
+		{
+			auto& resource = m_resources[id];
+			states[id] = resource.imported ? resource.initial : (resource.firstPass != UINT32_MAX ? GetTransientInitialState(id) : ImageState{});
+		}
+
+		auto transition = [&](std::vector<Barrier>& barriers, ResourceId id, const ImageState& next) {
+			auto& state = states[id];
+			bool needed = state.layout != next.layout || HasWrite(state.access) || HasWrite(next.access);
+			if (!needed)
+			{
+				state.stage |= next.stage;
+				state.access |= next.access;
+				return;
+			}
+			barriers.push_back(Barrier{
+				.resource = id,
+				.barrier = VkImageMemoryBarrier2{
+					.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+					.srcStageMask = state.stage,
+					// ǂݎ݂͎̌̏s̏ۏ؂΂悢.
+					.srcAccessMask = HasWrite(state.access) ? state.access : VK_ACCESS_2_NONE,
+					.dstStageMask = next.stage,
+					.dstAccessMask = next.access,
+					.oldLayout = state.layout,
+					.newLayout = next.layout,
+					.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+					.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+					.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+				},
+			});
+			state = next;
+		};
+
+		for (auto& pass : m_passes)
+		{
+			pass.barriers.clear();
+			if (pass.culled)
+			{
+				continue;
+			}
+			for (auto& access : pass.reads)
+			{
+				if (!Contains(pass.writes, access.resource))
+				{
+					transition(pass.barriers, access.resource, GetState(access.usage, false));
+				}
+			}
+			for (auto& access : pass.writes)
+			{
+				auto next = GetState(access.usage, true);
+				if (Contains(pass.reads, access.resource))
+				{
+					next.access |= GetState(access.usage, false).access;
+				}
+				transition(pass.barriers, access.resource, next);
+			}
+		}
+
+		// t[̏IɎ荞񂾃C[Ww̏Ԃɖ߂.
+		m_finalBarriers.clear();
+		for (ResourceId id = 0; id < ResourceId(m_resources.size()); ++id)
+		{
+			auto& resource = m_resources[id];
+			if (resource.imported && resource.final.layout != states[id].layout)
+			{
+				transition(m_finalBarriers, id, resource.final);
+			}
+		}
+	}
+
+	void RecordBarriers(VkCommandBuffer commandBuffer, std::vector<Barrier>& barriers)
+	{
+		if (barriers.empty())
+		{
+			return;
+		}
+		m_imageBarriers.clear();
+		for (auto& barrier : barriers)
+		{
+			barrier.barrier.image = m_resources[barrier.resource].image;
+			m_imageBarriers.push_back(barrier.barrier);
+		}
+		if (m_pipelineBarrier2 != nullptr)
+		{
+			VkDependencyInfo dependencyInfo{
+				.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+				.imageMemoryBarrierCount = uint32_t(m_imageBarriers.size()),
+				.pImageMemoryBarriers = m_imageBarriers.data(),
+			};
+			m_pipelineBarrier2(commandBuffer, &dependencyInfo);
+			return;
+		}
+
+		// gĂXe[WƃANZX̃rbg͋̒`ƓlȂ̂ŁÂ܂ܐ؂l߂Ďg.
+		VkPipelineStageFlags srcStage = 0;
+		VkPipelineStageFlags dstStage = 0;
+		m_legacyBarriers.clear();
+		for (auto& barrier : m_imageBarriers)
+		{
+			srcStage |= VkPipelineStageFlags(barrier.srcStageMask);
+			dstStage |= VkPipelineStageFlags(barrier.dstStageMask);
+			m_legacyBarriers.push_back(VkImageMemoryBarrier{
+				.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+				.srcAccessMask = VkAccessFlags(barrier.srcAccessMask),
+				.dstAccessMask = VkAccessFlags(barrier.dstAccessMask),
+				.oldLayout = barrier.oldLayout,
+				.newLayout = barrier.newLayout,
+				.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+				.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+				.image = barrier.image,
+				.subresourceRange = barrier.subresourceRange,
+			});
+		}
+		vkCmdPipelineBarrier(commandBuffer,
+			srcStage != 0 ? srcStage : VkPipelineStageFlags(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT),
+			dstStage != 0 ? dstStage : VkPipelineStageFlags(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT),
+			0, 0, nullptr, 0, nullptr, uint32_t(m_legacyBarriers.size()), m_legacyBarriers.data());
+	}
+
+	std::string DumpBarriers(const std::vector<Barrier>& barriers) const
+	{
+		std::string str;
+		for (auto& barrier : barriers)
+		{
+			auto& b = barrier.barrier;
+			str += std::format("  barrier {}: {} -> {}, stage 0x{:x} -> 0x{:x}, access 0x{:x} -> 0x{:x}\n",
+				m_resources[barrier.resource].name, LayoutName(b.oldLayout), LayoutName(b.newLayout),
+				uint64_t(b.srcStageMask), uint64_t(b.dstStageMask), uint64_t(b.srcAccessMask), uint64_t(b.dstAccessMask));
+		}
+		return str;
+	}
+
+	static const char* UsageName(Usage usage)
+	{
+		switch (usage)
+		{
+		case Usage::TransferSrc: return "transfer_src";
+		case Usage::TransferDst: return "transfer_dst";
+		case Usage::Sampled: return "sampled";
+		default: return "color_attachment";
+		}
+	}
+
+	static const char* LayoutName(VkImageLayout layout)
+	{
+		switch (layout)
+		{
+		case VK_IMAGE_LAYOUT_UNDEFINED: return "undefined";
+		case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL: return "color_attachment";
+		case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: return "shader_read_only";
+		case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: return "transfer_src";
+		case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL: return "transfer_dst";
+		case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR: return "present_src";
+		default: return "other";
+		}
+	}
+
+	VkDevice m_device = VK_NULL_HANDLE;
+	GpuAllocator* m_allocator = nullptr;
+	DeletionQueue* m_deletionQueue = nullptr;
+	PFN_vkCmdPipelineBarrier2 m_pipelineBarrier2 = nullptr;
+
+	std::vector<Resource> m_resources;
+	std::vector<Pass> m_passes;
+	std::vector<Barrier> m_finalBarriers;
+	bool m_compiled = false;
+
+	// ꎞC[WŜŋL郁.
+	GpuAllocation m_memory;
+	VkDeviceSize m_memoryBytes = 0;
+	VkDeviceSize m_unaliasedBytes = 0;
+
+	// L^̂тɊmۂȂ悤g.
+	std::vector<VkImageMemoryBarrier2> m_imageBarriers;
+	std::vector<VkImageMemoryBarrier> m_legacyBarriers;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// `𑜓x̔{ (cꂼɊ|l) At[Ԃ\ZɎ܂悤.
+// GPU ׂ͂̕悻fA܂{2ɔႷƂ݂ȂāA\Zɍ{ς.
+// {͒iKɊۂ߁AƂ͌ς܂ňxɁAグƂ͈iςėh}.
+class ResolutionScaler
+{
+public:
+	// budgetMs  0 Ȃ{ scale ̂܂ܕςȂ.
+	void Initialize(float scale, float minScale, double budgetMs)
+	{
+		m_minScale = std::clamp(minScale, MinScaleLimit, 1.0f);
+		m_scale = std::clamp(scale, m_minScale, 1.0f);
+		m_budgetMs = budgetMs;
+		m_smoothedMs = 0.0;
+		m_cooldown = 0;
+	}
+
+	// `It[̏v (GPU ̌vl CPU ̃t[) n.
+	// {ς true Ԃ.
+	bool Update(double frameMs)
+	{
+		if (m_budgetMs <= 0.0 || frameMs <= 0.0)
+		{
+			return false;
+		}
+		m_smoothedMs = (m_smoothedMs == 0.0) ? frameMs : m_smoothedMs + (frameMs - m_smoothedMs) * SmoothingFactor;
+		// ύX̌ʂvlɕ\܂ő҂.
+		if (m_cooldown > 0)
+		{
+			--m_cooldown;
+			return false;
+		}
+
+		auto estimate = float(m_scale * std::sqrt(m_budgetMs * Headroom / m_smoothedMs));
+		auto target = std::clamp(std::round(estimate / Step) * Step, m_minScale, 1.0f);
+		if (target > m_scale)
+		{
+			target = std::min(target, m_scale + Step);
+		}
+		if (std::abs(target - m_scale) < Step * 0.5f)
+		{
+			return false;
+		}
+		m_scale = target;
+		m_cooldown = CooldownFrames;
+		++m_changeCount;
+		return true;
+	}
+
+	bool IsDynamic() const { return m_budgetMs > 0.0; }
+	float GetScale() const { return m_scale; }
+	double GetSmoothedMs() const { return m_smoothedMs; }
+	double GetBudgetMs() const { return m_budgetMs; }
+	uint64_t GetChangeCount() const { return m_changeCount; }
+
+	// {|傫. 0 ɂ͂Ȃ.
+	static uint32_t Scale(uint32_t size, float scale)
+	{
+		return std::max(1u, uint32_t(std::lround(double(size) * scale)));
+	}
+
+private:
+	static constexpr float MinScaleLimit = 0.25f;
+	static constexpr float Step = 0.05f;
+	// \Zɑ΂Ă̊ڕWɂAh炬ŗ\Z𒴂ɂ.
+	static constexpr double Headroom = 0.9;
+	static constexpr double SmoothingFactor = 0.1;
+	static constexpr uint32_t CooldownFrames = 30;
+
+	float m_scale = 1.0f;
+	float m_minScale = 0.5f;
+	double m_budgetMs = 0.0;
+	double m_smoothedMs = 0.0;
+	uint32_t m_cooldown = 0;
+	uint64_t m_changeCount = 0;
+};
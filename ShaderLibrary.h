@@ -0,0 +1,349 @@
+#pragma once
+
+#include "Volk/volk.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
+#endif
+
+// ǂݎpŃ}bvt@C.
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile() { Close(); }
+
+	bool Open(const std::filesystem::path& path)
+	{
+		Close();
+#if defined(_WIN32)
+		m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+		LARGE_INTEGER size{};
+		if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+		{
+			Close();
+			return false;
+		}
+		m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		m_data = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		m_size = size_t(size.QuadPart);
+#else
+		m_file = open(path.c_str(), O_RDONLY);
+		if (m_file < 0)
+		{
+			return false;
+		}
+		struct stat status{};
+		if (fstat(m_file, &status) != 0 || status.st_size == 0)
+		{
+			Close();
+			return false;
+		}
+		m_size = size_t(status.st_size);
+		m_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+		if (m_data == MAP_FAILED)
+		{
+			m_data = nullptr;
+		}
+#endif
+		if (m_data == nullptr)
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	void Close()
+	{
+#if defined(_WIN32)
+		if (m_data != nullptr)
+		{
+			UnmapViewOfFile(m_data);
+		}
+		if (m_mapping != nullptr)
+		{
+			CloseHandle(m_mapping);
+		}
+		if (m_file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(m_file);
+		}
+		m_mapping = nullptr;
+		m_file = INVALID_HANDLE_VALUE;
+#else
+		if (m_data != nullptr)
+		{
+			munmap(m_data, m_size);
+		}
+		if (m_file >= 0)
+		{
+			close(m_file);
+		}
+		m_file = -1;
+#endif
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	const void* GetData() const { return m_data; }
+	size_t GetSize() const { return m_size; }
+
+private:
+#if defined(_WIN32)
+	HANDLE m_file = INVALID_HANDLE_VALUE;
+	HANDLE m_mapping = nullptr;
+#else
+	int m_file = -1;
+#endif
+	void* m_data = nullptr;
+	size_t m_size = 0;
+};
+
+// VF[_[W[fBNg .spv t@C.
+// t@CA܂ SPIR-V Ƃĕsȏꍇ́Agݍ݂̃VF[_[ (wb_ɖߍ񂾔z) g.
+// ĎJnƁAt@C̍XVobNOEh̃XbhŌoĒʒm.
+class ShaderLibrary
+{
+public:
+	// ύXꂽVF[_[̖O󂯎. ĎXbhĂ΂.
+	using ChangeFunc = std::function<void(const std::vector<std::string>& names)>;
+
+	// directory Ȃgݍ݂̃VF[_[g.
+	void Initialize(VkDevice device, const std::string& directory)
+	{
+		m_device = device;
+		m_directory = directory;
+	}
+
+	// name  directory ̑΃pX. Initialize() ̌AĎn߂Oɓo^.
+	void Register(const std::string& name, const uint32_t* embedded, size_t embeddedSize)
+	{
+		m_shaders[name] = Shader{
+			.embedded = embedded,
+			.embeddedSize = embeddedSize,
+			.lastWriteTime = GetLastWriteTime(name),
+		};
+	}
+
+	// Ăяoj. o^e͊ĎJnɕςȂ̂ŁAǂ̃XbhłĂׂ.
+	VkShaderModule CreateModule(const std::string& name, bool* loadedFromFile = nullptr) const
+	{
+		auto it = m_shaders.find(name);
+		if (it == m_shaders.end())
+		{
+			return VK_NULL_HANDLE;
+		}
+		const void* code = it->second.embedded;
+		size_t codeSize = it->second.embeddedSize;
+
+		// }bvt@Ĉ܂ܓn̂ŁAǂݍݗp̃Rs[͍Ȃ.
+		MappedFile file;
+		bool fromFile = !m_directory.empty() && file.Open(std::filesystem::path(m_directory) / name) && IsSpirv(file.GetData(), file.GetSize());
+		if (fromFile)
+		{
+			code = file.GetData();
+			codeSize = file.GetSize();
+		}
+		if (loadedFromFile)
+		{
+			*loadedFromFile = fromFile;
+		}
+
+		VkShaderModuleCreateInfo createInfo{
+			.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+			.codeSize = codeSize,
+			.pCode = static_cast<const uint32_t*>(code),
+		};
+		VkShaderModule module = VK_NULL_HANDLE;
+		vkCreateShaderModule(m_device, &createInfo, nullptr, &module);
+		return module;
+	}
+
+	void StartWatching(ChangeFunc onChanged)
+	{
+		if (m_directory.empty() || m_thread.joinable())
+		{
+			return;
+		}
+		m_onChanged = std::move(onChanged);
+		m_quit = false;
+#if defined(_WIN32)
+		m_quitEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+#endif
+		m_thread = std::thread([this]() { WatchMain(); });
+	}
+
+	void StopWatching()
+	{
+		if (!m_thread.joinable())
+		{
+			return;
+		}
+		m_quit = true;
+#if defined(_WIN32)
+		SetEvent(m_quitEvent);
+#endif
+		m_thread.join();
+#if defined(_WIN32)
+		CloseHandle(m_quitEvent);
+		m_quitEvent = nullptr;
+#endif
+	}
+
+	const std::string& GetDirectory() const { return m_directory; }
+	bool IsWatching() const { return m_thread.joinable(); }
+
+private:
+	struct Shader
+	{
+		const uint32_t* embedded = nullptr;
+		size_t embeddedSize = 0;
+		std::filesystem::file_time_type lastWriteTime;
+	};
+
+	static bool IsSpirv(const void* data, size_t size)
+	{
+		constexpr uint32_t SpirvMagic = 0x07230203;
+		return size >= 20 && size % 4 == 0 && *static_cast<const uint32_t*>(data) == SpirvMagic;
+	}
+
+	std::filesystem::file_time_type GetLastWriteTime(const std::string& name) const
+	{
+		std::error_code ec;
+		auto time = std::filesystem::last_write_time(std::filesystem::path(m_directory) / name, ec);
+		return ec ? std::filesystem::file_time_type{} : time;
+	}
+
+	// fBNg̕ύXʒm͋N̂ƂĂgAύX̗L͍XVŔ肷.
+	// GfB^RpCɂď݂̒ʒm̏oقȂ邽.
+	void WatchMain()
+	{
+#if defined(_WIN32)
+		HANDLE change = FindFirstChangeNotificationW(std::filesystem::path(m_directory).c_str(), FALSE,
+			FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+		while (!m_quit)
+		{
+			if (change != INVALID_HANDLE_VALUE)
+			{
+				HANDLE handles[] = { m_quitEvent, change };
+				if (WaitForMultipleObjects(2, handles, FALSE, INFINITE) != WAIT_OBJECT_0 + 1)
+				{
+					continue;
+				}
+				FindNextChangeNotification(change);
+			}
+			else
+			{
+				WaitForSingleObject(m_quitEvent, PollIntervalMs);
+			}
+			CheckChanges();
+		}
+		if (change != INVALID_HANDLE_VALUE)
+		{
+			FindCloseChangeNotification(change);
+		}
+#elif defined(__linux__)
+		int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (fd >= 0 && inotify_add_watch(fd, m_directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0)
+		{
+			close(fd);
+			fd = -1;
+		}
+		while (!m_quit)
+		{
+			if (fd >= 0)
+			{
+				// IvɋCt悤A҂Ԃ؂.
+				pollfd pfd{ .fd = fd, .events = POLLIN };
+				if (poll(&pfd, 1, PollIntervalMs) <= 0)
+				{
+					continue;
+				}
+				alignas(inotify_event) char buffer[4096];
+				while (read(fd, buffer, sizeof(buffer)) > 0)
+				{
+				}
+			}
+			else
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(PollIntervalMs));
+			}
+			CheckChanges();
+		}
+		if (fd >= 0)
+		{
+			close(fd);
+		}
+#else
+		while (!m_quit)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(PollIntervalMs));
+			CheckChanges();
+		}
+#endif
+	}
+
+	void CheckChanges()
+	{
+		std::vector<std::string> changed;
+		for (auto& [name, shader] : m_shaders)
+		{
+			auto time = GetLastWriteTime(name);
+			if (time != shader.lastWriteTime)
+			{
+				shader.lastWriteTime = time;
+				changed.push_back(name);
+			}
+		}
+		if (!changed.empty() && m_onChanged)
+		{
+			m_onChanged(changed);
+		}
+	}
+
+	static constexpr int PollIntervalMs = 250;
+
+	VkDevice m_device = VK_NULL_HANDLE;
+	std::string m_directory;
+	// ĎXbh lastWriteTime .
+	std::map<std::string, Shader> m_shaders;
+	ChangeFunc m_onChanged;
+	std::thread m_thread;
+	std::atomic<bool> m_quit = false;
+#if defined(_WIN32)
+	HANDLE m_quitEvent = nullptr;
+#endif
+};
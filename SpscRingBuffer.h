@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// ݃Xbh1AǂݏoXbh1Ŏgp郍bNt[̃Oobt@.
+// Capacity 2ׂ̂ł邱.
+template<class T, size_t Capacity>
+class SpscRingBuffer
+{
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+public:
+	SpscRingBuffer() : m_buffer(Capacity) {}
+
+	// ݑĂ. 󂫂 false Ԃ.
+	bool Push(const T& value)
+	{
+		auto head = m_head.load(std::memory_order_relaxed);
+		auto tail = m_tail.load(std::memory_order_acquire);
+		if (head - tail == Capacity)
+		{
+			return false;
+		}
+		m_buffer[head & (Capacity - 1)] = value;
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// ǂݏoĂ. ł false Ԃ.
+	bool Pop(T& value)
+	{
+		auto tail = m_tail.load(std::memory_order_relaxed);
+		auto head = m_head.load(std::memory_order_acquire);
+		if (tail == head)
+		{
+			return false;
+		}
+		value = m_buffer[tail & (Capacity - 1)];
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool IsEmpty() const
+	{
+		return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+	}
+
+private:
+	std::vector<T> m_buffer;
+	// ݈ʒuƓǂݏoʒu͕ʁX̃LbVCɒu.
+	alignas(64) std::atomic<size_t> m_head{ 0 };
+	alignas(64) std::atomic<size_t> m_tail{ 0 };
+};
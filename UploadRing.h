@@ -0,0 +1,203 @@
+#pragma once
+
+#include "Volk/volk.h"
+#include "DeletionQueue.h"
+#include "GpuAllocator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string>
+
+// UploadRing ؂o͈. data ɏ߂΂̂܂ GPU 猩.
+struct UploadAllocation
+{
+	VkBuffer buffer = VK_NULL_HANDLE;
+	VkDeviceSize offset = 0;
+	void* data = nullptr;
+
+	bool IsValid() const { return data != nullptr; }
+	// UploadRing::GetDescriptorSet() 𑩔Ƃ̓IItZbg.
+	uint32_t GetDynamicOffset() const { return uint32_t(offset); }
+};
+
+// iIɃ}bvzXgRq[gȃobt@At[̃XbgƂ̗̈ɕĎgO.
+// Xbg̗̈͂̃Xbg̑Õt[̊҂ BeginFrame() Ŋ߂̂ŁA
+// t[̊蓖Ă͐擪l߂Ăōς݁A}bv̏͗vȂ.
+class UploadRing
+{
+public:
+	// uniformRange ͓IItZbgŎQƂ郆jtH[obt@͈̔.
+	bool Initialize(VkDevice device, VkPhysicalDevice gpu, GpuAllocator& allocator, DeletionQueue& deletionQueue,
+		VkDeviceSize sizePerFrame, uint32_t frameCount, VkDeviceSize uniformRange)
+	{
+		m_device = device;
+		m_allocator = &allocator;
+		m_deletionQueue = &deletionQueue;
+
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(gpu, &properties);
+		m_minAlignment = std::max({
+			properties.limits.minUniformBufferOffsetAlignment,
+			properties.limits.minStorageBufferOffsetAlignment,
+			VkDeviceSize(16) });
+		m_uniformRange = std::min<VkDeviceSize>(uniformRange, properties.limits.maxUniformBufferRange);
+		m_partitionSize = AlignUp(std::max(sizePerFrame, m_uniformRange), m_minAlignment);
+
+		VkBufferCreateInfo bufferCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+			// Ō̗̖̈ł uniformRange QƂł悤]t.
+			.size = m_partitionSize * frameCount + m_uniformRange,
+			.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+				VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+				VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+		};
+		vkCreateBuffer(m_device, &bufferCreateInfo, nullptr, &m_buffer);
+		m_deletionQueue->Track(m_buffer);
+
+		VkMemoryRequirements memoryRequirements;
+		vkGetBufferMemoryRequirements(m_device, m_buffer, &memoryRequirements);
+		m_allocation = m_allocator->Allocate(memoryRequirements,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, true);
+		if (m_allocation.mapped == nullptr)
+		{
+			// zXg珑߂Ȃ. 蓖Ăׂ͂Ďs.
+			return false;
+		}
+		vkBindBufferMemory(m_device, m_buffer, m_allocation.memory, m_allocation.offset);
+		InitializeDescriptors();
+		return true;
+	}
+
+	void Shutdown(uint64_t serial)
+	{
+		m_deletionQueue->Destroy(m_descriptorPool, serial);
+		m_deletionQueue->Destroy(m_descriptorSetLayout, serial);
+		m_deletionQueue->Destroy(m_buffer, serial);
+		m_allocator->Free(m_allocation, serial);
+	}
+
+	// frameSlot ̑O̎gpɌĂ.
+	void BeginFrame(uint32_t frameSlot)
+	{
+		m_begin = m_partitionSize * frameSlot;
+		m_head = m_begin;
+	}
+
+	// alignment  0 ȂŏACg (jtH[obt@̃ItZbg) g.
+	// ̈悪Ȃ IsValid()  false ɂȂ.
+	UploadAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment = 0)
+	{
+		auto offset = AlignUp(m_head, std::max(alignment, m_minAlignment));
+		if (m_allocation.mapped == nullptr || offset + size > m_begin + m_partitionSize)
+		{
+			++m_overflowCount;
+			return {};
+		}
+		m_head = offset + size;
+		m_peakUsage = std::max(m_peakUsage, m_head - m_begin);
+		return UploadAllocation{
+			.buffer = m_buffer,
+			.offset = offset,
+			.data = static_cast<uint8_t*>(m_allocation.mapped) + offset,
+		};
+	}
+
+	template<class T>
+	UploadAllocation Push(const T& value)
+	{
+		auto allocation = Allocate(sizeof(T));
+		if (allocation.IsValid())
+		{
+			std::memcpy(allocation.data, &value, sizeof(T));
+		}
+		return allocation;
+	}
+
+	// binding 0  UNIFORM_BUFFER_DYNAMIC ƂăOŜwZbg.
+	VkDescriptorSetLayout GetDescriptorSetLayout() const { return m_descriptorSetLayout; }
+	VkDescriptorSet GetDescriptorSet() const { return m_descriptorSet; }
+
+	std::string FormatStats() const
+	{
+		return std::format("Upload ring: {} KiB per frame, peak {} KiB, {} overflows.\n",
+			m_partitionSize >> 10, m_peakUsage >> 10, m_overflowCount);
+	}
+
+private:
+	void InitializeDescriptors()
+	{
+		VkDescriptorSetLayoutBinding binding{
+			.binding = 0,
+			.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+			.descriptorCount = 1,
+			.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_COMPUTE_BIT,
+		};
+		VkDescriptorSetLayoutCreateInfo layoutCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+			.bindingCount = 1,
+			.pBindings = &binding,
+		};
+		vkCreateDescriptorSetLayout(m_device, &layoutCreateInfo, nullptr, &m_descriptorSetLayout);
+		m_deletionQueue->Track(m_descriptorSetLayout);
+
+		VkDescriptorPoolSize poolSize{
+			.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+			.descriptorCount = 1,
+		};
+		VkDescriptorPoolCreateInfo poolCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+			.maxSets = 1,
+			.poolSizeCount = 1,
+			.pPoolSizes = &poolSize,
+		};
+		vkCreateDescriptorPool(m_device, &poolCreateInfo, nullptr, &m_descriptorPool);
+		m_deletionQueue->Track(m_descriptorPool);
+
+		VkDescriptorSetAllocateInfo allocateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+			.descriptorPool = m_descriptorPool,
+			.descriptorSetCount = 1,
+			.pSetLayouts = &m_descriptorSetLayout,
+		};
+		vkAllocateDescriptorSets(m_device, &allocateInfo, &m_descriptorSet);
+
+		VkDescriptorBufferInfo bufferInfo{
+			.buffer = m_buffer,
+			.offset = 0,
+			.range = m_uniformRange,
+		};
+		VkWriteDescriptorSet write{
+			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			.dstSet = m_descriptorSet,
+			.dstBinding = 0,
+			.descriptorCount = 1,
+			.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+			.pBufferInfo = &bufferInfo,
+		};
+		vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+	}
+
+	static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	VkDevice m_device = VK_NULL_HANDLE;
+	GpuAllocator* m_allocator = nullptr;
+	DeletionQueue* m_deletionQueue = nullptr;
+	VkBuffer m_buffer = VK_NULL_HANDLE;
+	GpuAllocation m_allocation;
+	VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE;
+	VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+	VkDescriptorSet m_descriptorSet = VK_NULL_HANDLE;
+	VkDeviceSize m_minAlignment = 256;
+	VkDeviceSize m_uniformRange = 256;
+	VkDeviceSize m_partitionSize = 0;
+	VkDeviceSize m_begin = 0;
+	VkDeviceSize m_head = 0;
+	VkDeviceSize m_peakUsage = 0;
+	uint64_t m_overflowCount = 0;
+};
@@ -0,0 +1,435 @@
+// volk ̖̎|PʂɊ܂߂.
+#define VOLK_IMPLEMENTATION
+#include "FullscreenExclusiveApp.h"
+
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <sstream>
+
+// FullscreenExclusiveApp ̕`惋[v܂t[񂵁AViIƂ̌vʂo͂.
+// ł̓wbhXȂ̂ŁA\tgEFA Vulkan foCX (--gpu llvmpipe Ȃ) łsł.
+namespace
+{
+	// ParseCommandLine() ɓnŕ\v.
+	struct Scenario
+	{
+		const char* name;
+		std::vector<std::string> args;
+		// wbhXł̓v[gȂ̂ŁA--windowed ̂ƂӖ.
+		bool windowedOnly = false;
+	};
+
+	const std::vector<Scenario> BuiltinScenarios = {
+		{ "present-fifo", { "--present-mode", "fifo" }, true },
+		{ "present-mailbox", { "--present-mode", "mailbox" }, true },
+		{ "present-immediate", { "--present-mode", "immediate" }, true },
+		{ "frames-in-flight-1", { "--frames-in-flight", "1" } },
+		{ "frames-in-flight-2", { "--frames-in-flight", "2" } },
+		{ "frames-in-flight-3", { "--frames-in-flight", "3" } },
+		{ "swapchain-images-2", { "--swapchain-images", "2" } },
+		{ "swapchain-images-4", { "--swapchain-images", "4" } },
+		{ "resolution-720p", { "--width", "1280", "--height", "720" } },
+		{ "resolution-1440p", { "--width", "2560", "--height", "1440" } },
+		{ "resolution-2160p", { "--width", "3840", "--height", "2160" } },
+		// 2160p kĕ`悵Ag̓]܂߂ GPU Ԃ resolution-* Ɣׂ.
+		{ "render-scale-0.5", { "--width", "3840", "--height", "2160", "--render-scale", "0.5" } },
+		{ "render-scale-dynamic", { "--width", "3840", "--height", "2160", "--frame-budget-ms", "8" } },
+		// t[[g̐x (p50 ɋ߂Ap99 Ƃ̍) ƁAx[h̑҂̉e.
+		{ "fps-limit-120", { "--fps-limit", "120" } },
+		{ "low-latency", { "--low-latency" } },
+		// GPU 쓮̕`. IuWFNg 100 {ɂĂ CPU ̋L^ (record) قڕςȂ.
+		{ "objects-1000", { "--objects", "1000" } },
+		{ "objects-100000", { "--objects", "100000" } },
+		// F1/F2/F3 ̐؂ւJԂ.
+		{ "mode-switch-storm", { "--mode-switch-interval", "10" } },
+		// 100 t[Ƃ̐؂ւ 200 t[ڂɔrɂȂAŔȓrƃtH[JX̕AN.
+		{ "fault-recovery", { "--mode-switch-interval", "100", "--inject-fault", "out_of_date@50,suboptimal@150,exclusive_lost@250,focus@270" } },
+	};
+
+	struct BenchmarkOptions
+	{
+		uint64_t frames = 300;
+		// Wv珜擪̃t[.
+		uint64_t warmup = 30;
+		bool windowed = false;
+		std::string scenarioFilter;
+		std::string csvPath = "benchmark_results.csv";
+		std::string jsonPath;
+		std::string baselinePath;
+		// x[XC̈̊ (%) ܂ŋ.
+		double thresholdPercent = 10.0;
+		// Βl̏. 0 Ȃ画肵Ȃ.
+		double maxFrameMs = 0.0;
+		double maxRecreateMs = 0.0;
+		// ߂Ȃ. ׂẴViIɓn.
+		std::vector<std::string> appArgs;
+	};
+
+	struct ScenarioResult
+	{
+		std::string name;
+		uint64_t frames = 0;
+		double frameMeanMs = 0.0;
+		double frameP50Ms = 0.0;
+		double frameP95Ms = 0.0;
+		double frameP99Ms = 0.0;
+		double recordP50Ms = 0.0;
+		double recordP99Ms = 0.0;
+		uint64_t recreateCount = 0;
+		double recreateMeanMs = 0.0;
+		double recreateMaxMs = 0.0;
+		uint64_t recoveryCount = 0;
+		double recoveryMeanMs = 0.0;
+		double recoveryMaxMs = 0.0;
+	};
+
+	// ʂ̓R\[ɏo. AṽO (OutputLog) Ƃ͍Ȃ.
+	void Report(const std::string& message)
+	{
+		std::fputs(message.c_str(), stdout);
+		std::fflush(stdout);
+	}
+
+	// Ԃ̏₵lƂĎ󂯕től.
+	constexpr double MaxLimitMs = 1.0e6;
+
+	// sȒl΋L^ false Ԃ.
+	bool ParseBenchmarkOptions(const std::vector<std::string>& args, BenchmarkOptions* result)
+	{
+		BenchmarkOptions options;
+		bool valid = true;
+		for (size_t i = 0; i < args.size(); ++i)
+		{
+			const auto& arg = args[i];
+			bool hasValue = (i + 1) < args.size();
+			if (arg == "--frames" && hasValue)
+			{
+				// 0 ̓Avł͖Ӗ̂ŁAwbhX̃ViIIȂȂ.
+				valid &= ParseNumber(arg, args[++i], uint64_t(1), UINT64_MAX, &options.frames);
+			}
+			else if (arg == "--warmup" && hasValue)
+			{
+				valid &= ParseNumber(arg, args[++i], uint64_t(0), UINT64_MAX, &options.warmup);
+			}
+			else if (arg == "--windowed")
+			{
+				options.windowed = true;
+			}
+			else if (arg == "--scenario" && hasValue)
+			{
+				options.scenarioFilter = args[++i];
+			}
+			else if (arg == "--csv" && hasValue)
+			{
+				options.csvPath = args[++i];
+			}
+			else if (arg == "--json" && hasValue)
+			{
+				options.jsonPath = args[++i];
+			}
+			else if (arg == "--baseline" && hasValue)
+			{
+				options.baselinePath = args[++i];
+			}
+			else if (arg == "--threshold" && hasValue)
+			{
+				valid &= ParseNumber(arg, args[++i], 0.0, 1000.0, &options.thresholdPercent);
+			}
+			else if (arg == "--max-frame-ms" && hasValue)
+			{
+				valid &= ParseNumber(arg, args[++i], 0.0, MaxLimitMs, &options.maxFrameMs);
+			}
+			else if (arg == "--max-recreate-ms" && hasValue)
+			{
+				valid &= ParseNumber(arg, args[++i], 0.0, MaxLimitMs, &options.maxRecreateMs);
+			}
+			else
+			{
+				options.appArgs.push_back(arg);
+			}
+		}
+		options.warmup = std::min(options.warmup, options.frames - 1);
+		// eViIɓńAViI񂷑OɈx؂.
+		FullscreenExclusiveApp::AppSettings settings;
+		valid &= ParseCommandLine(options.appArgs, &settings);
+		*result = options;
+		return valid;
+	}
+
+	bool RunScenario(const Scenario& scenario, const BenchmarkOptions& options, ScenarioResult& result)
+	{
+		// ViI̎wɒuāAʂ̈D悳.
+		std::vector<std::string> args = options.appArgs;
+		args.insert(args.end(), scenario.args.begin(), scenario.args.end());
+		FullscreenExclusiveApp::AppSettings settings;
+		if (!ParseCommandLine(args, &settings))
+		{
+			return false;
+		}
+		settings.headless = !options.windowed;
+		settings.frameCount = options.frames;
+		// vɉet@Co͂Ď͍sȂ.
+		settings.profileCsvPath.clear();
+		settings.profileJsonPath.clear();
+		settings.shaderDirectory.clear();
+
+		FullscreenExclusiveApp app;
+		if (!app.Initialize(settings))
+		{
+			return false;
+		}
+		app.Run();
+		app.Shutdown();
+
+		std::vector<double> frameMs;
+		std::vector<double> recordMs;
+		const auto& history = app.GetProfiler().GetHistory();
+		for (size_t i = size_t(options.warmup); i < history.size(); ++i)
+		{
+			frameMs.push_back(history[i].frameMs);
+			recordMs.push_back(history[i].recordMs);
+		}
+		std::sort(frameMs.begin(), frameMs.end());
+		std::sort(recordMs.begin(), recordMs.end());
+
+		result.name = scenario.name;
+		result.frames = frameMs.size();
+		if (!frameMs.empty())
+		{
+			result.frameMeanMs = std::accumulate(frameMs.begin(), frameMs.end(), 0.0) / double(frameMs.size());
+		}
+		result.frameP50Ms = FrameProfiler::Percentile(frameMs, 50.0);
+		result.frameP95Ms = FrameProfiler::Percentile(frameMs, 95.0);
+		result.frameP99Ms = FrameProfiler::Percentile(frameMs, 99.0);
+		result.recordP50Ms = FrameProfiler::Percentile(recordMs, 50.0);
+		result.recordP99Ms = FrameProfiler::Percentile(recordMs, 99.0);
+
+		const auto& recreates = app.GetRecreateTimings();
+		result.recreateCount = recreates.size();
+		if (!recreates.empty())
+		{
+			result.recreateMeanMs = std::accumulate(recreates.begin(), recreates.end(), 0.0) / double(recreates.size());
+			result.recreateMaxMs = *std::max_element(recreates.begin(), recreates.end());
+		}
+
+		const auto& recovery = app.GetRecovery();
+		result.recoveryCount = recovery.GetRecoveryCount();
+		result.recoveryMeanMs = recovery.GetMeanRecoveryMs();
+		result.recoveryMaxMs = recovery.GetMaxRecoveryMs();
+		return true;
+	}
+
+	bool WriteCsv(const std::string& path, const std::vector<ScenarioResult>& results)
+	{
+		std::ofstream file(path);
+		if (!file)
+		{
+			return false;
+		}
+		file << "scenario,frames,frame_mean_ms,frame_p50_ms,frame_p95_ms,frame_p99_ms,recreate_count,recreate_mean_ms,recreate_max_ms,recovery_count,recovery_mean_ms,recovery_max_ms,record_p50_ms,record_p99_ms\n";
+		for (auto& r : results)
+		{
+			file << std::format("{},{},{:.4f},{:.4f},{:.4f},{:.4f},{},{:.4f},{:.4f},{},{:.4f},{:.4f},{:.4f},{:.4f}\n",
+				r.name, r.frames, r.frameMeanMs, r.frameP50Ms, r.frameP95Ms, r.frameP99Ms,
+				r.recreateCount, r.recreateMeanMs, r.recreateMaxMs,
+				r.recoveryCount, r.recoveryMeanMs, r.recoveryMaxMs,
+				r.recordP50Ms, r.recordP99Ms);
+		}
+		return bool(file);
+	}
+
+	bool WriteJson(const std::string& path, const std::vector<ScenarioResult>& results)
+	{
+		std::ofstream file(path);
+		if (!file)
+		{
+			return false;
+		}
+		file << "[\n";
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			auto& r = results[i];
+			file << std::format("  {{\"scenario\":\"{}\",\"frames\":{},\"frameMeanMs\":{:.4f},\"frameP50Ms\":{:.4f},"
+				"\"frameP95Ms\":{:.4f},\"frameP99Ms\":{:.4f},\"recreateCount\":{},\"recreateMeanMs\":{:.4f},\"recreateMaxMs\":{:.4f},"
+				"\"recoveryCount\":{},\"recoveryMeanMs\":{:.4f},\"recoveryMaxMs\":{:.4f},\"recordP50Ms\":{:.4f},\"recordP99Ms\":{:.4f}}}{}\n",
+				r.name, r.frames, r.frameMeanMs, r.frameP50Ms, r.frameP95Ms, r.frameP99Ms,
+				r.recreateCount, r.recreateMeanMs, r.recreateMaxMs,
+				r.recoveryCount, r.recoveryMeanMs, r.recoveryMaxMs,
+				r.recordP50Ms, r.recordP99Ms,
+				(i + 1 < results.size()) ? "," : "");
+		}
+		file << "]\n";
+		return bool(file);
+	}
+
+	// WriteCsv() ŏt@Cǂ݁AViIň悤ɂ.
+	// ǂ߂Ȃs΋L^ false Ԃ.
+	bool ReadBaseline(const std::string& path, std::map<std::string, ScenarioResult>* baseline)
+	{
+		std::ifstream file(path);
+		std::string line;
+		// 擪s͌o.
+		std::getline(file, line);
+		bool valid = true;
+		for (uint32_t lineNumber = 2; std::getline(file, line); ++lineNumber)
+		{
+			std::vector<std::string> fields;
+			std::stringstream stream(line);
+			for (std::string field; std::getline(stream, field, ',');)
+			{
+				fields.push_back(field);
+			}
+			auto location = std::format("{}:{}", path, lineNumber);
+			if (fields.size() < 9)
+			{
+				auto str = std::format("Invalid baseline row at {} ({} columns).\n", location, fields.size());
+				Report(str);
+				valid = false;
+				continue;
+			}
+			ScenarioResult r{ .name = fields[0] };
+			auto count = [&](size_t index, uint64_t* value) { valid &= ParseNumber(location, fields[index], uint64_t(0), UINT64_MAX, value); };
+			auto ms = [&](size_t index, double* value) { valid &= ParseNumber(location, fields[index], 0.0, MaxLimitMs, value); };
+			count(1, &r.frames);
+			ms(2, &r.frameMeanMs);
+			ms(3, &r.frameP50Ms);
+			ms(4, &r.frameP95Ms);
+			ms(5, &r.frameP99Ms);
+			count(6, &r.recreateCount);
+			ms(7, &r.recreateMeanMs);
+			ms(8, &r.recreateMaxMs);
+			// AԂƋL^Ԃ̗񂪖Â CSV ǂ߂悤ɂ.
+			if (fields.size() >= 12)
+			{
+				count(9, &r.recoveryCount);
+				ms(10, &r.recoveryMeanMs);
+				ms(11, &r.recoveryMaxMs);
+			}
+			if (fields.size() >= 14)
+			{
+				ms(12, &r.recordP50Ms);
+				ms(13, &r.recordP99Ms);
+			}
+			(*baseline)[r.name] = r;
+		}
+		return valid;
+	}
+
+	// ĂΗRo͂ false Ԃ.
+	bool CheckRegression(const ScenarioResult& r, const std::map<std::string, ScenarioResult>& baseline, const BenchmarkOptions& options)
+	{
+		bool passed = true;
+		auto fail = [&](const char* metric, double value, double limit)
+		{
+			auto str = std::format("REGRESSION {}: {} {:.3f} ms exceeds {:.3f} ms.\n", r.name, metric, value, limit);
+			Report(str);
+			passed = false;
+		};
+
+		if (options.maxFrameMs > 0.0 && r.frameP95Ms > options.maxFrameMs)
+		{
+			fail("frame p95", r.frameP95Ms, options.maxFrameMs);
+		}
+		if (options.maxRecreateMs > 0.0 && r.recreateMaxMs > options.maxRecreateMs)
+		{
+			fail("recreate max", r.recreateMaxMs, options.maxRecreateMs);
+		}
+
+		auto it = baseline.find(r.name);
+		if (it != baseline.end())
+		{
+			// ZԂ̗h炬ŎsȂ悤A킸ȍ͋.
+			constexpr double ToleranceMs = 0.05;
+			double scale = 1.0 + options.thresholdPercent / 100.0;
+			if (double limit = it->second.frameP95Ms * scale + ToleranceMs; r.frameP95Ms > limit)
+			{
+				fail("frame p95", r.frameP95Ms, limit);
+			}
+			if (double limit = it->second.recreateMeanMs * scale + ToleranceMs; r.recreateCount > 0 && r.recreateMeanMs > limit)
+			{
+				fail("recreate mean", r.recreateMeanMs, limit);
+			}
+			if (double limit = it->second.recoveryMeanMs * scale + ToleranceMs; r.recoveryCount > 0 && r.recoveryMeanMs > limit)
+			{
+				fail("recovery mean", r.recoveryMeanMs, limit);
+			}
+		}
+		return passed;
+	}
+
+	//  1Ax[XCsANłȂViI 2 Ԃ.
+	int RunBenchmark(const std::vector<std::string>& args)
+	{
+		BenchmarkOptions options;
+		if (!ParseBenchmarkOptions(args, &options))
+		{
+			return 2;
+		}
+		std::map<std::string, ScenarioResult> baseline;
+		if (!options.baselinePath.empty())
+		{
+			if (!ReadBaseline(options.baselinePath, &baseline) || baseline.empty())
+			{
+				auto str = std::format("Failed to read baseline {}.\n", options.baselinePath);
+				Report(str);
+				return 2;
+			}
+		}
+
+		std::vector<ScenarioResult> results;
+		bool failed = false;
+		bool regressed = false;
+		for (auto& scenario : BuiltinScenarios)
+		{
+			if (!options.scenarioFilter.empty() && std::string_view(scenario.name).find(options.scenarioFilter) == std::string_view::npos)
+			{
+				continue;
+			}
+			if (scenario.windowedOnly && !options.windowed)
+			{
+				auto str = std::format("{}: skipped (requires --windowed).\n", scenario.name);
+				Report(str);
+				continue;
+			}
+			ScenarioResult result;
+			if (!RunScenario(scenario, options, result))
+			{
+				auto str = std::format("Scenario {} failed to initialize.\n", scenario.name);
+				Report(str);
+				failed = true;
+				continue;
+			}
+			auto str = std::format("{}: frame mean {:.3f} / p50 {:.3f} / p95 {:.3f} / p99 {:.3f} ms, record p50 {:.3f} / p99 {:.3f} ms, {} recreates (mean {:.3f}, max {:.3f} ms), {} recoveries (mean {:.3f}, max {:.3f} ms)\n",
+				result.name, result.frameMeanMs, result.frameP50Ms, result.frameP95Ms, result.frameP99Ms,
+				result.recordP50Ms, result.recordP99Ms, result.recreateCount, result.recreateMeanMs, result.recreateMaxMs,
+				result.recoveryCount, result.recoveryMeanMs, result.recoveryMaxMs);
+			Report(str);
+			regressed |= !CheckRegression(result, baseline, options);
+			results.push_back(result);
+		}
+
+		if (!options.csvPath.empty() && !WriteCsv(options.csvPath, results))
+		{
+			auto str = std::format("Failed to write {}.\n", options.csvPath);
+			Report(str);
+		}
+		if (!options.jsonPath.empty() && !WriteJson(options.jsonPath, results))
+		{
+			auto str = std::format("Failed to write {}.\n", options.jsonPath);
+			Report(str);
+		}
+
+		if (failed)
+		{
+			return 2;
+		}
+		return regressed ? 1 : 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	// 擪͎st@CȂ̂œǂݔ΂.
+	return RunBenchmark(std::vector<std::string>(argv + 1, argv + argc));
+}
@@ -0,0 +1,26 @@
+#version 450
+
+layout(location=0) out vec3 outColor;
+
+// IuWFNgƂ̃f[^ (SoA). gl_InstanceIndex IuWFNg̔ԍ.
+layout(set=0, binding=0) readonly buffer ObjectBounds { vec4 bounds[]; };
+layout(set=0, binding=1) readonly buffer ObjectColors { vec4 colors[]; };
+
+layout(push_constant) uniform Params {
+  // xy: \͈͂̒S, zw: g嗦.
+  vec4 view;
+} params;
+
+vec2 positions[3] = vec2[](
+  vec2( 0.5, 0.5),
+  vec2( 0.0, -0.5),
+  vec2(-0.5, 0.5)
+);
+
+void main()
+{
+  vec4 b = bounds[gl_InstanceIndex];
+  vec2 p = positions[gl_VertexIndex] * b.w + b.xy;
+  gl_Position = vec4((p - params.view.xy) * params.view.zw, 0.5, 1);
+  outColor = colors[gl_InstanceIndex].rgb;
+}